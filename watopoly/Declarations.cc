@@ -4,10 +4,27 @@ export module watopoly;
 import <vector>;
 import <string>;
 import <map>;
+import <unordered_map>;
 import <utility>;
 import <random>;
 import <sstream>;
+import <fstream>;
 import <iostream>;
+import <deque>;
+import <functional>;
+import <cstdint>;
+import <type_traits>;
+import <memory>;
+import <mutex>;
+import <chrono>;
+import <bit>;
+import <array>;
+import <span>;
+import <new>;
+import <cstddef>;
+import <initializer_list>;
+import <algorithm>;
+import <stdexcept>;
 
 using namespace std;
 using std::size_t;
@@ -21,6 +38,226 @@ export class Tile;
 export class CommandInterpreter;
 export class AcademicBuilding;
 export class Property;
+export class Game;
+export class CommandLog;
+export class Board;
+
+//----------------------------------
+// RANDOM
+//----------------------------------
+// xoshiro256** seeded through splitmix64. Bounded draws use integer rejection
+// rather than <random> distributions, so a seed replays the same game with
+// every compiler and standard library.
+export class Rng {
+private:
+    std::uint64_t state[4];
+    std::uint64_t draws = 0;
+
+public:
+    explicit Rng(std::uint64_t seed = 0);
+    void seed(std::uint64_t seed);
+    std::uint64_t next();
+    void saveState(std::uint64_t out[4]) const;
+    void loadState(const std::uint64_t in[4]);
+    int uniform(int bound);                       // 0 <= result < bound
+    bool chance(int numerator, int denominator);  // true with probability numerator/denominator
+    std::uint64_t drawCount() const { return draws; } // numbers drawn since construction
+};
+
+//----------------------------------
+// ALIAS TABLE
+//----------------------------------
+// Walker/Vose alias sampler over integer weights. Building is O(n) and done once;
+// a draw costs one random number and a table lookup.
+export class AliasTable {
+private:
+    std::vector<int> values;
+    std::vector<std::uint32_t> keep;   // chance out of total that a column keeps its own value
+    std::vector<std::uint32_t> alias;  // column to fall back to otherwise
+    std::uint32_t total;
+
+public:
+    explicit AliasTable(const std::vector<std::pair<int, int>>& weightedValues); // value, weight
+    int draw(Rng& rng) const;
+};
+
+//----------------------------------
+// OUTPUT
+//----------------------------------
+// Every engine message goes through the active sink of the calling thread.
+// The console sink is the interactive default; the buffered sink writes in
+// large blocks and ignores std::endl flushes; the null sink drops everything.
+export class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+    virtual std::ostream& stream() = 0;
+    virtual std::ostream& errorStream() = 0;
+    virtual void flush() {}
+    virtual bool discards() const { return false; } // true if nothing written is ever seen
+};
+
+export class ConsoleSink : public OutputSink {
+public:
+    std::ostream& stream() override { return std::cout; }
+    std::ostream& errorStream() override { return std::cerr; }
+    void flush() override { std::cout.flush(); }
+};
+
+export class BufferedSink : public OutputSink {
+private:
+    class BlockBuffer : public std::streambuf {
+    private:
+        std::vector<char> block;
+    protected:
+        int_type overflow(int_type ch) override;
+        int sync() override { return 0; } // std::endl only ends the line
+    public:
+        explicit BlockBuffer(std::size_t capacity);
+        void drain();
+    };
+    BlockBuffer buffer;
+    std::ostream out;
+
+public:
+    explicit BufferedSink(std::size_t capacity = 1 << 16);
+    ~BufferedSink() override;
+    std::ostream& stream() override { return out; }
+    std::ostream& errorStream() override { return std::cerr; }
+    void flush() override { buffer.drain(); }
+};
+
+export class NullSink : public OutputSink {
+private:
+    std::ostream sink{nullptr}; // no buffer, so every write fails fast
+public:
+    std::ostream& stream() override { return sink; }
+    std::ostream& errorStream() override { return sink; }
+    bool discards() const override { return true; }
+};
+
+// What rule code writes its messages to. It forwards to the active sink's stream,
+// but while that sink discards everything it formats nothing: inserting into a
+// failed stream still costs as much as the rest of a headless turn.
+export class GameOutput {
+private:
+    std::ostream* stream; // nullptr while the sink discards
+public:
+    explicit GameOutput(std::ostream* stream) : stream{stream} {}
+    template <typename T>
+    GameOutput& operator<<(const T& value) {
+        if (stream) *stream << value;
+        return *this;
+    }
+    GameOutput& operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+        if (stream) *stream << manipulator;
+        return *this;
+    }
+};
+
+export OutputSink& outputSink();
+export void setOutputSink(OutputSink* sink); // nullptr restores the console
+export std::ostream& output();       // the raw stream, for block writes and reports
+export std::ostream& errorOutput();
+export GameOutput gameOutput();
+
+//----------------------------------
+// MEMORY
+//----------------------------------
+// The real limits of a game: the board has 40 tiles and there are 8 pieces.
+export constexpr int maxTiles = 40;
+export constexpr int maxPieces = 8;
+
+// Bump allocator for objects that live and die together. Objects are carved out
+// of 16 KiB blocks; those with destructors are remembered and destroyed newest
+// first on rewind. The blocks themselves are kept for reuse until the arena dies.
+export class Arena {
+private:
+    static constexpr std::size_t blockSize = 16 * 1024;
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t size;
+    };
+    struct Cleanup {
+        void* object;
+        void (*destroy)(void*);
+    };
+    std::vector<Block> blocks;
+    std::vector<Cleanup> cleanups;
+    std::size_t current = 0; // block being filled
+    std::size_t used = 0;    // bytes taken from it
+    void* allocate(std::size_t size, std::size_t alignment);
+
+public:
+    struct Mark {
+        std::size_t block = 0;
+        std::size_t used = 0;
+        std::size_t cleanups = 0;
+    };
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena() { rewind(Mark{}); }
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        T* object = ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            cleanups.push_back({object, [](void* p) { static_cast<T*>(p)->~T(); }});
+        }
+        return object;
+    }
+    Mark mark() const { return {current, used, cleanups.size()}; }
+    void rewind(const Mark& mark); // destroys everything made since mark in one step
+    std::size_t reserved() const;  // bytes held in blocks
+};
+
+// Vector with inline storage and a fixed capacity, for pointers and other
+// trivially copyable values. Growing past N throws std::length_error.
+export template <typename T, std::size_t N>
+class FixedVector {
+    static_assert(std::is_trivially_copyable_v<T>, "FixedVector holds plain values only");
+private:
+    T items[N];
+    std::size_t count = 0;
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    FixedVector() = default;
+    FixedVector(std::initializer_list<T> values) {
+        for (const T& value : values) push_back(value);
+    }
+
+    void push_back(const T& value) {
+        if (count == N) throw std::length_error("FixedVector is full");
+        items[count++] = value;
+    }
+    iterator erase(const_iterator position) {
+        iterator at = items + (position - items);
+        std::copy(at + 1, end(), at);
+        --count;
+        return at;
+    }
+    void pop_back() { --count; }
+    void clear() { count = 0; }
+
+    T& operator[](std::size_t i) { return items[i]; }
+    const T& operator[](std::size_t i) const { return items[i]; }
+    T& back() { return items[count - 1]; }
+    const T& back() const { return items[count - 1]; }
+    T* data() { return items; }
+    const T* data() const { return items; }
+    iterator begin() { return items; }
+    iterator end() { return items + count; }
+    const_iterator begin() const { return items; }
+    const_iterator end() const { return items + count; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr std::size_t capacity() { return N; }
+};
 
 //----------------------------------
 // DICE
@@ -33,10 +270,12 @@ private:
 
 public:
     Dice(bool testMode = false);
-    void roll();
+    void roll(Rng& rng);
     void setTestDice(int d1, int d2);
     int getTotal() const;
     bool isDoubles() const;
+    int getDie1() const { return die1; }
+    int getDie2() const { return die2; }
 };
 
 //----------------------------------
@@ -66,6 +305,237 @@ export class Bank {
       }
   };
 
+//----------------------------------
+// DECISIONS
+//----------------------------------
+// Every choice the rules ask a player for goes through a DecisionProvider,
+// so rule code never blocks on the terminal itself.
+export class DecisionProvider {
+  public:
+    virtual ~DecisionProvider() = default;
+
+    virtual bool buyProperty(Player* player, Property* property) = 0;
+    virtual bool payTuitionFlatFee(Player* player, int flatFee, int percentFee) = 0;
+    virtual bool useTimsCup(Player* player) = 0;
+    virtual bool payToLeaveTims(Player* player) = 0;
+    // Index into player->getProperties() to sell to the bank, or -1 to cancel
+    virtual int chooseAssetToSell(Player* player, int amountOwed) = 0;
+    virtual bool acceptTrade(Player* target, const std::string& offer) = 0;
+    virtual bool confirmBankruptcy(Player* player) = 0;
+    // Name of the player to hand assets to, or "bank"
+    virtual std::string chooseCreditor(Player* player) = 0;
+    // A bid that does not beat highestBid means the bidder drops out
+    virtual int bid(Player* bidder, Property* property, int highestBid) = 0;
+    // Index into player->getProperties() to mortgage before selling anything, or -1 to go on to selling
+    virtual int chooseAssetToMortgage(Player* player, int amountOwed) = 0;
+    // Asked before an automatic player rolls: a building to improve, or nullptr to roll
+    virtual AcademicBuilding* chooseImprovement(Player* player) = 0;
+    // True when the provider plays player's turns itself instead of mainLoop reading commands
+    virtual bool controlsTurn(Player*) { return false; }
+    // Called as a game is set up, so nothing learned in an earlier game carries over
+    virtual void newGame() {}
+};
+
+// Reads every answer from std::cin, the classic interactive game
+export class ConsoleDecisions : public DecisionProvider {
+  public:
+    bool buyProperty(Player* player, Property* property) override;
+    bool payTuitionFlatFee(Player* player, int flatFee, int percentFee) override;
+    bool useTimsCup(Player* player) override;
+    bool payToLeaveTims(Player* player) override;
+    int chooseAssetToSell(Player* player, int amountOwed) override;
+    bool acceptTrade(Player* target, const std::string& offer) override;
+    bool confirmBankruptcy(Player* player) override;
+    std::string chooseCreditor(Player* player) override;
+    int bid(Player* bidder, Property* property, int highestBid) override;
+    int chooseAssetToMortgage(Player* player, int amountOwed) override;
+    AcademicBuilding* chooseImprovement(Player* player) override;
+};
+
+// Answers with callbacks when they are set, and with a simple default policy otherwise:
+// buy what is affordable, pay the cheaper tuition, spend cups, wait out Tims Line,
+// sell the oldest holding without mortgaging, reject trades, stay out of auctions
+// and build every monopoly up while $200 is left over
+export class ProgrammaticDecisions : public DecisionProvider {
+  public:
+    std::function<bool(Player*, Property*)> onBuyProperty;
+    std::function<bool(Player*, int, int)> onPayTuitionFlatFee;
+    std::function<bool(Player*)> onUseTimsCup;
+    std::function<bool(Player*)> onPayToLeaveTims;
+    std::function<int(Player*, int)> onChooseAssetToSell;
+    std::function<bool(Player*, const std::string&)> onAcceptTrade;
+    std::function<bool(Player*)> onConfirmBankruptcy;
+    std::function<std::string(Player*)> onChooseCreditor;
+    std::function<int(Player*, Property*, int)> onBid;
+    std::function<int(Player*, int)> onChooseAssetToMortgage;
+    std::function<AcademicBuilding*(Player*)> onChooseImprovement;
+
+    bool buyProperty(Player* player, Property* property) override;
+    bool payTuitionFlatFee(Player* player, int flatFee, int percentFee) override;
+    bool useTimsCup(Player* player) override;
+    bool payToLeaveTims(Player* player) override;
+    int chooseAssetToSell(Player* player, int amountOwed) override;
+    bool acceptTrade(Player* target, const std::string& offer) override;
+    bool confirmBankruptcy(Player* player) override;
+    std::string chooseCreditor(Player* player) override;
+    int bid(Player* bidder, Property* property, int highestBid) override;
+    int chooseAssetToMortgage(Player* player, int amountOwed) override;
+    AcademicBuilding* chooseImprovement(Player* player) override;
+};
+
+// Answers from a queue of console-style tokens ("y", "2", "accept", "bank", "pass", ...).
+// Once the queue runs dry it defers to the fallback, or throws if there is none.
+// Improvements are never asked for: a scripted turn types its improve commands.
+export class ScriptedDecisions : public DecisionProvider {
+  private:
+    std::deque<std::string> answers;
+    DecisionProvider* fallback;
+    bool next(std::string& answer);
+    DecisionProvider& exhausted();
+
+  public:
+    ScriptedDecisions(std::deque<std::string> answers = {}, DecisionProvider* fallback = nullptr);
+    void push(const std::string& answer);
+    void clear() { answers.clear(); }
+    std::size_t remaining() const { return answers.size(); }
+
+    bool buyProperty(Player* player, Property* property) override;
+    bool payTuitionFlatFee(Player* player, int flatFee, int percentFee) override;
+    bool useTimsCup(Player* player) override;
+    bool payToLeaveTims(Player* player) override;
+    int chooseAssetToSell(Player* player, int amountOwed) override;
+    bool acceptTrade(Player* target, const std::string& offer) override;
+    bool confirmBankruptcy(Player* player) override;
+    std::string chooseCreditor(Player* player) override;
+    int bid(Player* bidder, Property* property, int highestBid) override;
+    int chooseAssetToMortgage(Player* player, int amountOwed) override;
+    AcademicBuilding* chooseImprovement(Player* player) override;
+};
+
+// Passes every choice on to another provider and keeps the answers as
+// ScriptedDecisions tokens, so the same choices can be fed back later.
+// Improvement choices turn into improve commands, so they are passed on unrecorded.
+export class RecordingDecisions : public DecisionProvider {
+  private:
+    DecisionProvider* inner;
+    std::vector<std::string> answers;
+
+  public:
+    explicit RecordingDecisions(DecisionProvider* inner = nullptr) : inner{inner} {}
+    void setInner(DecisionProvider* provider) { inner = provider; }
+    DecisionProvider* getInner() const { return inner; }
+    bool controlsTurn(Player* player) override { return inner->controlsTurn(player); }
+    // Hands over the answers recorded so far and starts a fresh list
+    std::vector<std::string> take();
+
+    bool buyProperty(Player* player, Property* property) override;
+    bool payTuitionFlatFee(Player* player, int flatFee, int percentFee) override;
+    bool useTimsCup(Player* player) override;
+    bool payToLeaveTims(Player* player) override;
+    int chooseAssetToSell(Player* player, int amountOwed) override;
+    bool acceptTrade(Player* target, const std::string& offer) override;
+    bool confirmBankruptcy(Player* player) override;
+    std::string chooseCreditor(Player* player) override;
+    int bid(Player* bidder, Property* property, int highestBid) override;
+    int chooseAssetToMortgage(Player* player, int amountOwed) override;
+    AcademicBuilding* chooseImprovement(Player* player) override;
+};
+
+// Sends each choice to the provider of the seat making it, so the players
+// of one game can follow different policies
+export class SeatedDecisions : public DecisionProvider {
+  private:
+    const Game& game;
+    std::vector<DecisionProvider*> bySeat;
+    DecisionProvider& of(const Player* player);
+
+  public:
+    explicit SeatedDecisions(const Game& game) : game{game} {}
+    // Seat i answers with bySeat[i % size]
+    void assign(std::vector<DecisionProvider*> providers) { bySeat = std::move(providers); }
+    bool controlsTurn(Player* player) override { return of(player).controlsTurn(player); }
+    void newGame() override { for (DecisionProvider* provider : bySeat) provider->newGame(); }
+
+    bool buyProperty(Player* player, Property* property) override;
+    bool payTuitionFlatFee(Player* player, int flatFee, int percentFee) override;
+    bool useTimsCup(Player* player) override;
+    bool payToLeaveTims(Player* player) override;
+    int chooseAssetToSell(Player* player, int amountOwed) override;
+    bool acceptTrade(Player* target, const std::string& offer) override;
+    bool confirmBankruptcy(Player* player) override;
+    std::string chooseCreditor(Player* player) override;
+    int bid(Player* bidder, Property* property, int highestBid) override;
+    int chooseAssetToMortgage(Player* player, int amountOwed) override;
+    AcademicBuilding* chooseImprovement(Player* player) override;
+};
+
+// Named automatic policies, for the seats of game. "mcts" searches with every core
+// allowed by searchThreads (0 for all); "mcts:n" spends n rollouts a decision.
+// Throws invalid_argument for an unknown name.
+export std::unique_ptr<DecisionProvider> makeStrategy(const std::string& name, const Game& game, unsigned searchThreads = 1);
+export std::vector<std::string> strategyNames();
+export bool isStrategy(const std::string& name);
+
+//----------------------------------
+// BOTS
+//----------------------------------
+// Automatic players. A bot answers every choice from the asking player's own
+// holdings, so a decision costs well under a microsecond, and it plays its own
+// turns when mainLoop meets its seat. The base class is a balanced player;
+// the strategies below change what a property is worth to them and how much
+// cash they keep back.
+export class Bot : public DecisionProvider {
+  protected:
+    int reserve; // cash kept back when buying, bidding and building
+
+    explicit Bot(int reserve) : reserve{reserve} {}
+    // The most the bot would pay for property, from the bank or at auction
+    virtual int valueOf(Player* player, Property* property);
+    bool affords(const Player* player, int cost) const; // and still keeps the reserve
+
+  public:
+    bool controlsTurn(Player*) override { return true; }
+    bool buyProperty(Player* player, Property* property) override;
+    bool payTuitionFlatFee(Player* player, int flatFee, int percentFee) override;
+    bool useTimsCup(Player* player) override;
+    bool payToLeaveTims(Player* player) override;
+    int chooseAssetToSell(Player* player, int amountOwed) override;
+    bool acceptTrade(Player* target, const std::string& offer) override;
+    bool confirmBankruptcy(Player* player) override;
+    std::string chooseCreditor(Player* player) override;
+    int bid(Player* bidder, Property* property, int highestBid) override;
+    int chooseAssetToMortgage(Player* player, int amountOwed) override;
+    AcademicBuilding* chooseImprovement(Player* player) override;
+};
+
+// Buys and bids on anything it can pay for, and builds until the cash runs out
+export class BuyEverythingBot : public Bot {
+  public:
+    BuyEverythingBot() : Bot{0} {}
+};
+
+// Pays extra for buildings in blocks it has started, most for the one that
+// completes a block, and passes on gyms unless they come cheap at auction
+export class MonopolyBot : public Bot {
+  protected:
+    int valueOf(Player* player, Property* property) override;
+
+  public:
+    MonopolyBot() : Bot{150} {}
+};
+
+// Keeps a large cash pile: buys only what costs a quarter of its cash,
+// bids low, and never pays to leave Tims Line
+export class CashHoarderBot : public Bot {
+  protected:
+    int valueOf(Player* player, Property* property) override;
+
+  public:
+    CashHoarderBot() : Bot{500} {}
+    bool buyProperty(Player* player, Property* property) override;
+    bool payToLeaveTims(Player* player) override;
+};
+
 //----------------------------------
 // PLAYER
 //----------------------------------
@@ -78,23 +548,25 @@ export class Player {
     bool inTimsLine;
     int turnsInTimsLine;
     int timsCups;
-    std::vector<Property*> properties;
+    const Board& board;   // maps holding bits back to properties
+    std::uint64_t owned;  // one bit per purchasable tile, see Holdings
+    bool raiseByMortgage(Game& game, int amountOwed); // true if a mortgage raised cash
 
   public:
-    Player(std::string name, char piece);
+    Player(std::string name, char piece, const Board& board);
 
     void move(int steps);
     void teleport(int destination);
     void incrementTurnsInTimsLine(); // new stuff
-    bool payMoney(int amount, Player* recipient = nullptr);
-    bool payMoneyToBank(int amount, Bank& recipient);
+    bool payMoney(Game& game, int amount, Player* recipient = nullptr);
+    bool payMoneyToBank(Game& game, int amount);
     void receiveMoney(int amount);
     bool validStep(int step);
-    bool ownsMonopoly(std::string blockName);
+    bool ownsMonopoly(const AcademicBuilding* building) const;
     bool buyProperty(Property* property);
     bool buyImprovement(AcademicBuilding* property);
-    bool unmortgageProperty(Property* property);
-    void sellProperty(Property* property);
+    bool unmortgageProperty(Game& game, Property* property);
+    int sellProperty(Property* property); // returns what the bank paid
     bool mortgageProperty(Property* property);
     bool sellImprovement(AcademicBuilding* property);
     int getNetWorth();
@@ -103,35 +575,65 @@ export class Player {
     bool canPayAmount(int amount);
     void enterTimsLine();
     void leaveTimsLine();
-    void addTimsCup();
+    void addTimsCup(Game& game);
     bool useTimsCup();
     std::string getAssets();
+    void acquireProperty(Property* property); // takes ownership without paying
+    void releaseProperty(Property* property); // hands the property back to the bank
+    // Overwrites the scalar state and drops every holding, used when restoring a GameState
+    void restoreState(char piece, int money, int position, bool inTimsLine, int turnsInTimsLine, int timsCups);
     
     // Inline getters
-    std::string getName() const { return name; }
+    const std::string& getName() const { return name; }
     char getPiece() const { return piece; }
     int getMoney() const { return money; }
     int getPosition() const { return position; }
     bool isInTimsLine() const { return inTimsLine; }
     int getTurnsInTimsLine() const { return turnsInTimsLine; }
     int getTimsCups() const { return timsCups; }
-    const std::vector<Property*>& getProperties() const { return properties; }
+    int getResidencesOwned() const;
+    int getGymsOwned() const;
+    int getOwnedInBlock(int blockId) const;
+    std::uint64_t getHoldings() const { return owned; }
+    const Board& getBoard() const { return board; }
+    std::uint64_t getMonopolies() const; // holding bits of every complete block
+    FixedVector<Property*, maxTiles> getProperties() const; // in board order
 };
 
 //----------------------------------
 // TILE
 //----------------------------------
+// What a tile is, so board logic can branch on a tag instead of RTTI.
+// Purchasable kinds come first so isProperty() is a single compare.
+export enum class TileKind : unsigned char {
+    AcademicBuilding,
+    Residence,
+    Gym,
+    CollectOSAP,
+    CoopFee,
+    GoToTims,
+    TimsLine,
+    NeedlesHall,
+    SLC,
+    Tuition,
+    GooseNesting
+};
+
 export class Tile {
   private: 
     std::string name;
     std::size_t location;
+    TileKind kind;
       
   public:
-    Tile(string name, std::size_t location): name{name}, location{location} {}
+    Tile(string name, std::size_t location, TileKind kind): name{name}, location{location}, kind{kind} {}
     virtual ~Tile() = default;
 
+    TileKind getKind() const { return kind; }
+    bool isProperty() const { return kind <= TileKind::Gym; }
+
     // fetches the name of the tile
-    virtual std::string getName() const {
+    virtual const std::string& getName() const {
       return this->name;
     }
         
@@ -140,21 +642,43 @@ export class Tile {
     }
     
     // Pure virtual method that must be implemented by all derived classes
-    virtual void landedOn(Player* player) = 0;
+    virtual void landedOn(Game& game, Player* player) = 0;
 };
 
 
+//----------------------------------
+// HOLDINGS
+//----------------------------------
+// Ownership as bitboards. The board numbers its purchasable tiles 0, 1, ... in
+// board order and each gets one bit; a player's holdings are a mask of those
+// bits. The board keeps mortgages as one mask and improvements as a 4-bit
+// count per tile, two to a byte.
+export struct Holdings {
+    static_assert(maxTiles <= 64, "a holding mask has a bit per tile");
+    std::uint64_t mortgaged = 0;
+    std::array<std::uint8_t, maxTiles / 2> improvements{};
+
+    int improvementsAt(int bit) const { return improvements[bit >> 1] >> ((bit & 1) * 4) & 0xf; }
+    void setImprovements(int bit, int count) {
+        const int shift = (bit & 1) * 4;
+        improvements[bit >> 1] = (improvements[bit >> 1] & ~(0xf << shift)) | (count & 0xf) << shift;
+    }
+};
+
 //----------------------------------
 // PROPERTY
 //----------------------------------
 export class Property : public Tile {
 private:
   size_t purchaseCost;
-  bool mortgaged;
   Player* owner;
+
+protected:
+  Holdings* holdings = nullptr; // the board's mortgage and improvement bits
+  int bit = -1;
   
 public:
-  Property(string name, size_t location, size_t purchaseCost);
+  Property(string name, size_t location, size_t purchaseCost, TileKind kind);
   virtual ~Property();
   
   size_t getPurchaseCost() const;
@@ -163,12 +687,17 @@ public:
   virtual bool unmortgage();
   void setOwner(Player* newOwner);
   Player* getOwner() const;
+  void setMortgaged(bool isMortgaged);
+  void placeOn(Holdings* holdings, int bit); // called once by the board that owns the tile
+  int getBit() const { return bit; }
+  std::uint64_t getMask() const { return std::uint64_t{1} << bit; }
+  virtual void reset(); // returns the property to the bank, unmortgaged
   
   // Pure virtual method for getting tuition
   virtual int getTuition() = 0;
   
   // Override landedOn from Tile
-  virtual void landedOn(Player* player) override;
+  virtual void landedOn(Game& game, Player* player) override;
 };
 
 
@@ -181,9 +710,11 @@ export class AcademicBuilding : public Property {
 private:
     int tuitionBase;
     int improvementCost;
-    int improvements;
     vector<int> tuitionWithImprovements;
     string monopolyBlock;
+    int blockId;   // interned by Board::initializeBoard
+    int blockSize; // number of buildings sharing blockId
+    std::uint64_t blockMask = 0; // holding bits of the whole block
 
 public:
     AcademicBuilding(string name, int position, int cost, int improvementCost, string block, vector<int> tuitionValues);
@@ -192,10 +723,17 @@ public:
     bool addImprovement();
     bool removeImprovement();
     int getImprovements() const;
+    void setImprovements(int count);
     int getImprovementCost() const;
+    int getTuitionAt(int level) const; // tuition with level improvements
     string getMonopolyBlock() const;
+    int getBlockId() const { return blockId; }
+    int getBlockSize() const { return blockSize; }
+    std::uint64_t getBlockMask() const { return blockMask; }
+    void setBlock(int id, int size, std::uint64_t mask);
     bool canMortgage() const;
     bool mortgage() override;
+    void reset() override;
 };
 
 //----------------------------------
@@ -224,6 +762,18 @@ public:
     int getTuition() override;
 };
 
+//----------------------------------
+// TILE CASTS
+//----------------------------------
+// Checked downcasts that read the kind tag; nullptr when the tile is something else
+export inline Property* asProperty(Tile* tile) {
+    return tile && tile->isProperty() ? static_cast<Property*>(tile) : nullptr;
+}
+
+export inline AcademicBuilding* asAcademicBuilding(Tile* tile) {
+    return tile && tile->getKind() == TileKind::AcademicBuilding ? static_cast<AcademicBuilding*>(tile) : nullptr;
+}
+
 //----------------------------------
 // SPECIAL TILES
 //----------------------------------
@@ -232,21 +782,21 @@ public:
 export class CollectOSAP : public Tile {
 public:
     CollectOSAP(int position);
-    void landedOn(Player* player) override;
+    void landedOn(Game& game, Player* player) override;
 };
 
 // COOP FEE
 export class CoopFee : public Tile {
 public:
     CoopFee(int position);
-    void landedOn(Player* player) override;
+    void landedOn(Game& game, Player* player) override;
 };
 
 // GO TO TIMS
 export class GoToTims : public Tile {
 public:
     GoToTims(int position);
-    void landedOn(Player* player) override;
+    void landedOn(Game& game, Player* player) override;
 };
 
 // TIMS LINE
@@ -254,35 +804,35 @@ export class TimsLine : public Tile {
 public:
     TimsLine(int position);
     ~TimsLine() override = default;
-    void landedOn(Player* player) override;
+    void landedOn(Game& game, Player* player) override;
 };
 
 // NEEDLES HALL
 export class NeedlesHall : public Tile {
 private:
-    std::vector<std::pair<int, double>> money_changes;
+    const AliasTable& money_changes; // shared by every Needles Hall tile
 
 public:
     NeedlesHall(int position);
-    void landedOn(Player* player) override;
+    void landedOn(Game& game, Player* player) override;
     bool tryGiveTimsCup(Player* player);
 };
 
 // SLC (Student Life Centre)
 export class SLC : public Tile {
 private:
-    std::vector<std::pair<int, double>> movements;
+    const AliasTable& movements; // shared by every SLC tile
 
 public:
     SLC(int position);
-    void landedOn(Player* player) override;
+    void landedOn(Game& game, Player* player) override;
 };
 
 // TUITION
 export class Tuition : public Tile {
 public:
     Tuition(int position);
-    void landedOn(Player* player) override;
+    void landedOn(Game& game, Player* player) override;
 };
 
 // GOOSE NESTING
@@ -298,7 +848,7 @@ private:
 
 public:
     GooseNesting(int position);
-    void landedOn(Player* player) override;
+    void landedOn(Game& game, Player* player) override;
 };
 
 //----------------------------------
@@ -306,55 +856,254 @@ public:
 //----------------------------------
 export class Board { 
   private:
-    vector<Tile*> tiles{};
+    Arena ownArena;                  // used when the board stands alone
+    Arena& arena;                    // holds the tiles
+    FixedVector<Tile*, maxTiles> tiles;
+    FixedVector<Property*, maxTiles> properties; // indexed by property bit
+    Holdings holdings;
+    std::array<std::uint64_t, maxTiles> blockMasks{}; // indexed by monopoly block ID
+    int blockCount = 0;
+    std::array<int, maxTiles> purchaseCosts{};     // by property bit
+    std::array<int, maxTiles> improvementCosts{};  // by property bit, 0 off academic buildings
+    std::uint64_t residenceMask = 0;
+    std::uint64_t gymMask = 0;
     map<string, vector<AcademicBuilding*>> academicBlocks;
+    std::unordered_map<string, int> propertyIndex; // property name -> board position
+    vector<string> boardTemplate;               // board.txt, read on first display
+    vector<std::pair<int, int>> tileCells;      // line and first column of each tile's piece slots
+    vector<string> lastFrame;                   // what the terminal shows, for diff rendering
+    bool templateLoaded = false;
+    bool diffRendering = false;
+    void loadTemplate();
 
   public:
     Board();
+    explicit Board(Arena& arena); // tiles live as long as arena
+    Board(const Board&) = delete;
+    Board& operator=(const Board&) = delete;
     void initializeBoard();
-    void display();
+    void display(std::span<Player* const> players);
+    void setDiffRendering(bool enabled); // redraw only changed cells with ANSI cursor moves
     void printTileInfo() const;
-    Tile* getTile(int position);
+    Tile* getTile(int position) const;
+    int getTileCount() const { return static_cast<int>(tiles.size()); }
+    const map<string, vector<AcademicBuilding*>>& getAcademicBlocks() const { return academicBlocks; }
+    Property* getPropertyByBit(int bit) const { return properties[bit]; }
+    std::uint64_t getBlockMask(int blockId) const { return blockId >= 0 && blockId < maxTiles ? blockMasks[blockId] : 0; }
+    std::uint64_t getResidenceMask() const { return residenceMask; }
+    std::uint64_t getGymMask() const { return gymMask; }
+    const Holdings& getHoldings() const { return holdings; }
+    int getHoldingValue(std::uint64_t mask) const; // purchase and improvement costs of the masked tiles
+    std::uint64_t getMonopolies(std::uint64_t mask) const; // the blocks mask holds completely
     Property* getPropertyByName(const string& name);
+    Property* findProperty(const string& name) const; // same lookup, never prints
+    void landOn(Game& game, Tile* tile, Player* player);
+    void reset();
     void movePlayer(Player* player, int steps);
     void teleportPlayer(Player* player, int destination);
     void sendToTimsLine(Player* player);
 };
 
+//----------------------------------
+// GAME STATE
+//----------------------------------
+// Flat, trivially copyable image of everything that changes during a game,
+// indexed by seat and by board position. Copying one is a plain memcpy.
+export struct GameState {
+    static constexpr int maxPlayers = maxPieces;
+    static constexpr int numTiles = maxTiles;
+    static constexpr std::uint8_t noOwner = 0xff;     // tile belongs to the bank
+    static constexpr std::uint8_t inTimsLine = 0x01;  // playerFlags
+    static constexpr std::uint8_t bankrupt = 0x02;    // playerFlags
+    static constexpr std::uint8_t mortgaged = 0x10;   // tileFlags; the low nibble counts improvements
+
+    std::uint64_t rng[4];
+    std::int32_t cash[maxPlayers];
+    std::uint8_t position[maxPlayers];
+    std::uint8_t playerFlags[maxPlayers];
+    std::uint8_t turnsInTimsLine[maxPlayers];
+    std::uint8_t timsCups[maxPlayers];
+    char piece[maxPlayers];
+    std::uint8_t owner[numTiles];      // seat index or noOwner
+    std::uint8_t tileFlags[numTiles];
+    std::uint8_t numSeats;
+    std::uint8_t currentPlayer;        // seat index
+    std::uint8_t cupsInGame;
+};
+
+static_assert(std::is_trivially_copyable_v<GameState>);
+static_assert(sizeof(GameState) <= 256);
+
+//----------------------------------
+// SNAPSHOT
+//----------------------------------
+// Binary save file: this header, the GameState image at a fixed 8-byte aligned
+// offset, then each seat's name as a length byte and its characters. The
+// checksum covers everything after the header. Integers are little-endian.
+export struct SnapshotHeader {
+    static constexpr std::uint32_t magic = 0x53544157; // "WATS"
+    static constexpr std::uint16_t currentVersion = 1;
+
+    std::uint32_t tag;
+    std::uint16_t version;
+    std::uint16_t stateSize;   // sizeof(GameState) of the writer
+    std::uint32_t payloadSize; // bytes after the header
+    std::uint32_t reserved;
+    std::uint64_t checksum;    // FNV-1a over the payload
+};
+
+static_assert(sizeof(SnapshotHeader) == 24);
+
+//----------------------------------
+// GAME RESULT
+//----------------------------------
+export struct GameResult {
+    std::string winner;   // last player standing, or the richest one if the turn limit was hit
+    bool finished = false; // true when every other player went bankrupt
+    int turns = 0;         // player turns; a roll of doubles does not start a new one
+    std::vector<std::pair<std::string, int>> balances{}; // final cash in seat order
+    int winnerSeat = -1;
+    std::vector<int> netWorths{}; // in seat order, 0 for bankrupt seats
+};
+
+//----------------------------------
+// METRICS
+//----------------------------------
+// Latency distribution in power-of-two buckets of nanoseconds: recording is a
+// bit_width and three adds, quantiles are read back as bucket upper bounds.
+export class LatencyHistogram {
+private:
+    static constexpr int numBuckets = 64;
+    std::uint64_t buckets[numBuckets + 1] = {}; // bucket b holds [2^(b-1), 2^b) ns
+    std::uint64_t count = 0;
+    std::uint64_t totalNs = 0;
+    std::uint64_t maxNs = 0;
+
+public:
+    void record(std::uint64_t ns) {
+        buckets[std::bit_width(ns)]++;
+        count++;
+        totalNs += ns;
+        maxNs = ns > maxNs ? ns : maxNs;
+    }
+    std::uint64_t getCount() const { return count; }
+    double meanNs() const { return count ? static_cast<double>(totalNs) / count : 0; }
+    std::uint64_t getMaxNs() const { return maxNs; }
+    std::uint64_t quantileNs(double q) const; // upper bound of the bucket holding quantile q
+};
+
+// Adds the time until it goes out of scope to a histogram
+export class ScopedTimer {
+private:
+    LatencyHistogram& histogram;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(LatencyHistogram& histogram)
+        : histogram{histogram}, start{std::chrono::steady_clock::now()} {}
+    ~ScopedTimer() {
+        histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+// Every counter and timer the engine keeps, one registry per game so games on
+// different threads never share a cache line. Fixed fields rather than names
+// keep an event to a plain increment.
+export class Metrics {
+public:
+    enum Verb { Roll, Next, Trade, Improve, Mortgage, Unmortgage, Bankrupt, Assets, All, Save, Stats, Invalid, numVerbs };
+    static Verb verbOf(const std::string& action);
+    static const char* verbName(Verb verb);
+
+    std::uint64_t commands[numVerbs] = {};
+    LatencyHistogram commandTime[numVerbs];
+    std::uint64_t rentPayments[maxTiles] = {};  // by board position
+    std::uint64_t rentPaid[maxTiles] = {};      // dollars, by board position
+    std::uint64_t auctions = 0;
+    std::uint64_t bankruptcies = 0;
+    std::uint64_t timsLineEntries = 0;
+    LatencyHistogram displayTime;
+    LatencyHistogram saveTime;
+    LatencyHistogram loadTime;
+
+    void recordRent(int position, int amount) {
+        rentPayments[position]++;
+        rentPaid[position] += amount;
+    }
+    void reset() { *this = Metrics{}; }
+    void report(std::ostream& out, const Board& board) const;
+};
+
 //----------------------------------
 // GAME
 //----------------------------------
 export class Game {
     private:
+        Arena arena;                  // tiles, players and the interpreter, freed together
+        Arena::Mark seatsMark;        // where the players start in arena
         Board board;
-        std::vector<Player*> players;
+        FixedVector<Player*, maxPieces> seats;   // every player that joined
+        std::unordered_map<std::string, int> seatIndex; // player name -> seat
+        FixedVector<Player*, maxPieces> players; // players still in the game, in turn order
         int currentPlayerIndex;
+        Rng rng;
         class Dice dice;
         class Bank bank;
         int maxTimsCups;
         bool isTestingMode;
-        static Game* instance;
+        ConsoleDecisions consoleDecisions;
+        DecisionProvider* decisions;
         CommandInterpreter* commandInterpreter;
+        std::vector<CommandLog*> commandLogs;
+        mutable Metrics metrics; // saving a const game still counts
+        void runCommand(const std::string& command);
+        void playBotTurn(Player* bot);
+        void clearSeats();
+        Player* addSeat(const std::string& name, char piece);
+        void checkState(const GameState& state) const; // throws runtime_error on the first bad field
         
     public:
         int currentTimsCupsInGame;
         Game(bool testMode = false);
-        ~Game();
-        static Game* getInstance();
         void removeBankruptPlayer(Player* bankruptPlayer);
         Dice& getDice(); 
+        Rng& getRng() { return rng; }
+        const Rng& getRng() const { return rng; }
+        void seed(std::uint64_t seed) { rng.seed(seed); }
         Bank& getBank() { return bank; }
-        void initialize(int numPlayers);
-        static bool canGiveTimsCup();
+        // Prompts for every seat but the last botSeats, which are named Bot1, Bot2, ...
+        void initialize(int numPlayers, int botSeats = 0);
+        void initialize(const std::vector<std::pair<std::string, char>>& roster);
+        void saveState(GameState& state) const;
+        void loadState(const GameState& state); // throws runtime_error, leaving the game as it was, if inconsistent
+        void writeSnapshot(std::string& buffer) const;
+        // Works straight from memory, e.g. a mapped file; throws runtime_error if corrupt
+        void readSnapshot(const char* data, std::size_t size);
+        void saveSnapshot(const std::string& filename) const;
+        void loadSnapshot(const std::string& filename);
         void loadGame(std::string filename);
         void saveGame(std::string filename);
         void mainLoop();
         bool canGiveMoreCups();
         void nextPlayer();
+        void playRoll();
+        GameResult runHeadless(int maxTurns);
+        DecisionProvider& getDecisions() { return *decisions; }
+        void setDecisionProvider(DecisionProvider* provider); // nullptr restores the console
+        bool isActive(const Player* player) const;
         std::vector<Player*> getPlayers();
-        Player* getPlayerByName(const std::string& name); // TO IMPLEMENT
+        Player* getPlayerByName(const std::string& name); // active players only
+        int getSeat(const Player* player) const; // -1 if the player is not seated
+        int getSeatCount() const { return seats.size(); }
         Board& getBoard(); // TO IMPLEMENT
         void processCommand(std::string command);
+        bool isTesting() const { return isTestingMode; }
+        Metrics& getMetrics() const { return metrics; }
+        void addCommandLog(CommandLog* log);
+        void removeCommandLog(CommandLog* log);
         void endGame();
         void auctionProperty(Property* property);
         int getNumPlayers() const;
@@ -386,4 +1135,300 @@ private:
     void executeAssets();
     void executeAll();
     void executeSave(const std::vector<std::string>& args);
+    void executeStats();
+};
+
+//----------------------------------
+// HEADLESS ENGINE
+//----------------------------------
+// Plays complete games with no prompts, no board rendering and no stream output.
+// The same Game is reused between games so the board files are only read once.
+export class HeadlessEngine {
+private:
+    Game game;
+    ProgrammaticDecisions defaultDecisions;
+    SeatedDecisions seated;
+    NullSink quiet;
+
+public:
+    HeadlessEngine();
+    void seed(std::uint64_t seed) { game.seed(seed); }
+    const Game& getGame() const { return game; }
+    // Answers every choice in later games with provider, nullptr restores the default policy
+    void setDecisionProvider(DecisionProvider* provider);
+    // Gives every seat its own provider, seat i answering with providers[i % size]
+    void setSeatDecisions(std::vector<DecisionProvider*> providers);
+    GameResult play(int numPlayers, int maxTurns = 1000);
+    // Continues a captured position to the end, drawing from the state's own RNG stream
+    GameResult play(const GameState& from, int maxTurns = 1000);
+};
+
+//----------------------------------
+// COMMAND LOGS
+//----------------------------------
+// Observes every command mainLoop processes. A record holds the RNG draws the
+// command consumed, the dice it left showing, the decision answers it received
+// and the command line, one record per text line; replaying a record feeds the
+// answers back and checks that the draws and dice come out the same.
+export class CommandLog {
+protected:
+    Game* game = nullptr;
+    RecordingDecisions recorder;
+    std::uint64_t drawsBefore = 0;
+
+    void attach(Game& game);
+    void detach();
+    void writeRecord(std::ostream& out, const std::string& command);
+
+public:
+    virtual ~CommandLog() = default;
+    // Runs one record against game; false if it consumed different draws or dice
+    static bool replayRecord(Game& game, ScriptedDecisions& scripted, const std::string& record);
+    void begin();
+    virtual void commit(const std::string& command) = 0;
+};
+
+//----------------------------------
+// JOURNAL
+//----------------------------------
+// Append-only log for crash recovery. Every checkpointInterval records the game
+// is written to <path>.snap and the journal restarts, naming that snapshot by
+// its checksum. Records are flushed to the OS one at a time, so they survive a
+// crash of the process; a torn last line is ignored on recovery.
+export class Journal : public CommandLog {
+private:
+    std::string path;
+    std::ofstream file;
+    int checkpointInterval;
+    int sinceCheckpoint = 0;
+
+public:
+    explicit Journal(std::string path, int checkpointInterval = 64);
+    ~Journal() override;
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Restores game from the last checkpoint plus the journal tail. Returns false when
+    // there is nothing to recover; throws runtime_error if the tail does not replay.
+    bool recover(Game& game);
+    // Checkpoints game and journals every command it processes from now on
+    void start(Game& game);
+    void commit(const std::string& command) override;
+    void checkpoint();
+};
+
+//----------------------------------
+// RECORD AND REPLAY
+//----------------------------------
+// A recording is one self-contained file: the seed and testing mode, a snapshot of
+// the starting position, every command record and the checksum of the end position.
+// Replaying needs a Game created in the same testing mode.
+export class SessionRecorder : public CommandLog {
+private:
+    std::ofstream file;
+
+public:
+    explicit SessionRecorder(const std::string& path);
+    ~SessionRecorder() override;
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    void start(Game& game, std::uint64_t seed);
+    void commit(const std::string& command) override;
+    // Writes the end position's checksum; called by the destructor if needed
+    void finish();
+};
+
+export struct ReplayReport {
+    int commands = 0;
+    int divergedAt = 0;            // first record that replayed differently, 0 if none
+    std::uint64_t expectedHash = 0;
+    std::uint64_t actualHash = 0;
+    double seconds = 0;            // time spent replaying commands
+    bool matches() const { return divergedAt == 0 && expectedHash == actualHash; }
 };
+
+// Reads whether a recording was made in testing mode; throws runtime_error if unreadable
+export bool recordedInTestingMode(const std::string& path);
+// Replays a recording into game with all output dropped; throws runtime_error if unreadable
+export ReplayReport replaySession(const std::string& path, Game& game);
+
+// Checksum of the whole game position, names included
+export std::uint64_t stateHash(const Game& game);
+
+//----------------------------------
+// LANDING ANALYSIS
+//----------------------------------
+// Exact long-run landing odds from a Markov chain over where a token rests between
+// rolls: every tile, plus three Tims Line states for the turns already waited.
+// One step is one roll of 2d6 with the engine's rules: Go To Tims and the SLC
+// card table move the token without a second landing, and a token in Tims Line
+// leaves on doubles or on its third turn (earlier too if payToLeave is set).
+export struct LandingAnalysis {
+    std::vector<double> landing;  // chance that a roll's move ends on each tile, which is when rent is due
+    std::vector<double> resting;  // where a token sits between rolls, outside Tims Line
+    double inTimsLine[3];         // sitting in Tims Line after 0, 1 or 2 failed turns
+    double rollsPerTurn;          // doubles earn another roll
+    int iterations;               // power-iteration steps until convergence
+};
+
+export LandingAnalysis analyzeLandings(const Board& board, bool payToLeave = false);
+
+//----------------------------------
+// IMPROVEMENT RETURNS
+//----------------------------------
+// What each step of developing a monopoly block earns, assuming the block is
+// built up evenly. Level 0 is buying the bare buildings; level n means every
+// building in the block has n improvements. Rents are per opponent turn, using
+// the per-turn landing odds from a LandingAnalysis.
+export struct BlockReturn {
+    std::string block;
+    int level;
+    int cost;                // to reach this level from the one below
+    double rentPerTurn;      // expected tuition from the whole block at this level
+    double marginalRent;     // rentPerTurn minus the level below
+    double paybackTurns;     // opponent turns for marginalRent to repay cost
+    double returnPerDollar;  // marginalRent per dollar of cost
+};
+
+export std::vector<BlockReturn> improvementReturns(const Board& board, const LandingAnalysis& landings);
+
+//----------------------------------
+// SIMULATION FARM
+//----------------------------------
+// Spreads index ranges over threads. Each worker owns a range and eats it from
+// the front a grain at a time; a worker that runs dry steals the back half of
+// the largest range left, so uneven game lengths still keep every core busy.
+export class WorkStealingPool {
+private:
+    struct alignas(64) Range {
+        std::mutex lock;
+        std::uint64_t begin = 0;
+        std::uint64_t end = 0;
+    };
+    std::vector<Range> ranges;
+    std::uint64_t grain;
+
+    bool take(unsigned worker, std::uint64_t& begin, std::uint64_t& end);
+    bool steal(unsigned worker);
+
+public:
+    // threads == 0 uses every core
+    explicit WorkStealingPool(unsigned threads = 0, std::uint64_t grain = 64);
+    unsigned size() const { return ranges.size(); }
+    // Calls task(worker, begin, end) over slices covering [0, count) exactly once; returns when all are done
+    void run(std::uint64_t count, const std::function<void(unsigned, std::uint64_t, std::uint64_t)>& task);
+};
+
+export struct SimJob {
+    std::uint64_t games = 1000;
+    int players = 4;
+    // Seat s of game g plays strategies[(s + g) % size], so every strategy gets every seat
+    std::vector<std::string> strategies{"default"};
+    std::uint64_t firstSeed = 0;  // game g is seeded with firstSeed + g
+    int maxTurns = 1000;
+    unsigned threads = 0;         // 0 uses every core
+    std::uint64_t grain = 64;     // games a worker takes at a time
+};
+
+// Only whole-number sums, so merging in any order gives the same totals
+export struct SimTotals {
+    std::uint64_t games = 0;
+    std::uint64_t finished = 0;
+    std::uint64_t turns = 0;
+    std::vector<std::uint64_t> seatWins;
+    std::map<std::string, std::uint64_t> strategyGames;  // seats played
+    std::map<std::string, std::uint64_t> strategyWins;
+    void merge(const SimTotals& other);
+};
+
+// Plays every game of the job, one engine per worker; throws invalid_argument for a bad job
+export SimTotals runSimulation(const SimJob& job);
+
+//----------------------------------
+// MONTE CARLO SEARCH
+//----------------------------------
+// A bot that weighs a choice by playing the game out many times from copies of
+// the current GameState: flat UCB1 over the candidate actions, each search
+// thread running its own rollouts (root parallelism) and the statistics summed
+// at the end. The engine asks for choices from inside its rules rather than
+// through a move generator, so the tree is the root alone. What carries over
+// between turns is a table of action statistics keyed by a coarse description
+// of the decision; they seed the next similar search of the same game at
+// reduced weight. Rollouts are seeded from the position and the decision alone,
+// so a game plays the same whichever games the bot played before it.
+export struct MctsConfig {
+    int rollouts = 2000;        // per decision, across all threads
+    double milliseconds = 100;  // stop early once this much time is spent, 0 for no limit
+    int horizon = 200;          // turns a rollout plays before scoring by net worth
+    unsigned threads = 0;       // 0 uses every core
+    double exploration = 1.4;
+    double reuseWeight = 0.5;   // share of carried-over statistics kept when they are reused
+};
+
+export class MctsBot : public Bot {
+  private:
+    struct Stats {
+        double visits = 0;
+        double value = 0;  // summed rollout scores, 1 for a win
+    };
+    using Action = std::function<void(GameState&)>;
+
+    const Game& game;
+    MctsConfig config;
+    WorkStealingPool pool;
+    std::vector<std::unique_ptr<HeadlessEngine>> engines; // one per search thread
+    std::unordered_map<std::uint64_t, Stats> reuse; // cleared by newGame
+    std::uint64_t rollouts = 0;
+    std::uint64_t auctionKey = 0; // the auction the limit below was searched for
+    int auctionLimit = 0;
+
+    // Statistics for each candidate from seat's point of view. A candidate changes a
+    // copy of the current state, then the turn passes on and the rollout starts.
+    std::vector<Stats> search(int seat, std::uint64_t decision, const std::vector<Action>& candidates);
+    static int mostVisited(const std::vector<Stats>& stats);
+
+  public:
+    explicit MctsBot(const Game& game, MctsConfig config = {});
+    std::uint64_t getRollouts() const { return rollouts; } // played so far, over all decisions
+
+    void newGame() override;
+    bool buyProperty(Player* player, Property* property) override;
+    bool useTimsCup(Player* player) override;
+    bool payToLeaveTims(Player* player) override;
+    bool acceptTrade(Player* target, const std::string& offer) override;
+    int bid(Player* bidder, Property* property, int highestBid) override;
+    AcademicBuilding* chooseImprovement(Player* player) override;
+};
+
+//----------------------------------
+// TOURNAMENT
+//----------------------------------
+// Rates strategies against each other. A table is a set of strategies that
+// plays once per seat rotation; every game ranks its table by the winner, then
+// net worth, and each pair of seats counts as one head-to-head result. Ratings
+// are the Bradley-Terry fit of those results on the Elo scale (400 points is
+// 10:1 odds, 1500 average) with 95% intervals from the fit's curvature.
+export struct TournamentConfig {
+    std::vector<std::string> strategies;
+    bool swiss = false;              // otherwise round-robin: every table of every size
+    std::vector<int> playerCounts{2, 3, 4, 5, 6};
+    int rounds = 5;                  // Swiss rounds; round r uses playerCounts[r % size]
+    int repeats = 1;                 // games per seat rotation of a table
+    std::uint64_t seed = 0;          // game n of the tournament is seeded with seed + n
+    int maxTurns = 1000;
+    unsigned threads = 0;            // 0 uses every core
+};
+
+export struct Rating {
+    std::string strategy;
+    double rating;
+    double low;                      // 95% confidence interval
+    double high;
+    std::uint64_t games;
+    std::uint64_t wins;              // games won outright or by net worth at the turn limit
+    double score;                    // share of head-to-head results won, draws counting half
+};
+
+// Best rating first; throws invalid_argument for a bad configuration
+export std::vector<Rating> runTournament(const TournamentConfig& config);
@@ -9,9 +9,19 @@ import <vector>;
 import <map>;
 import <utility>;
 import <cstdlib>;
-import <ctime>;
 import <cctype>; 
 import <stdexcept>;
+import <cstdio>;
+import <cstring>;
+import <cstdint>;
+import <iterator>;
+import <chrono>;
+import <limits>;
+import <memory>;
+import <mutex>;
+import <thread>;
+import <exception>;
+import <cmath>;
 
 using namespace std;
 
@@ -36,36 +46,249 @@ namespace utilities {
       return std::isdigit(c); 
     });
   }
+
+  // Points this thread's output at another sink for as long as it lives
+  class SinkSwap {
+    OutputSink& saved;
+  public:
+    explicit SinkSwap(OutputSink& sink) : saved{outputSink()} { setOutputSink(&sink); }
+    ~SinkSwap() { setOutputSink(&saved); }
+    SinkSwap(const SinkSwap&) = delete;
+    SinkSwap& operator=(const SinkSwap&) = delete;
+  };
+
+  // Selling these to the bank throws away the improvements or the mortgage
+  inline bool isDeveloped(Property* property) {
+    AcademicBuilding* academic = asAcademicBuilding(property);
+    return property->isMortgaged() || (academic && academic->getImprovements() > 0);
+  }
 }
 
 //----------------------------------
-// DICE IMPLEMENTATION
+// RANDOM IMPLEMENTATION
 //----------------------------------
 
-Dice::Dice(bool testMode) : die1{0}, die2{0}, isTestMode{testMode} {}
+Rng::Rng(std::uint64_t seed) {
+  this->seed(seed);
+}
 
-// Rolls two six-sided dice unless in test mode
-void Dice::roll() {
-  if (isTestMode) {
-    return;
+// Expands the seed into the four state words with splitmix64
+void Rng::seed(std::uint64_t seed) {
+  for (auto& word : state) {
+    seed += 0x9e3779b97f4a7c15ULL;
+    std::uint64_t z = seed;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    word = z ^ (z >> 31);
+  }
+}
+
+std::uint64_t Rng::next() {
+  auto rotl = [](std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); };
+  const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+  const std::uint64_t t = state[1] << 17;
+  ++draws;
+  state[2] ^= state[0];
+  state[3] ^= state[1];
+  state[1] ^= state[2];
+  state[0] ^= state[3];
+  state[2] ^= t;
+  state[3] = rotl(state[3], 45);
+  return result;
+}
+
+void Rng::saveState(std::uint64_t out[4]) const {
+  std::copy(state, state + 4, out);
+}
+
+void Rng::loadState(const std::uint64_t in[4]) {
+  std::copy(in, in + 4, state);
+}
+
+// Lemire's multiply-shift with rejection, so every value is equally likely
+int Rng::uniform(int bound) {
+  const std::uint32_t range = bound;
+  std::uint64_t product = (next() >> 32) * range;
+  std::uint32_t low = static_cast<std::uint32_t>(product);
+  if (low < range) {
+    const std::uint32_t threshold = -range % range;
+    while (low < threshold) {
+      product = (next() >> 32) * range;
+      low = static_cast<std::uint32_t>(product);
+    }
+  }
+  return static_cast<int>(product >> 32);
+}
+
+bool Rng::chance(int numerator, int denominator) {
+  return uniform(denominator) < numerator;
+}
+
+//----------------------------------
+// ALIAS TABLE IMPLEMENTATION
+//----------------------------------
+
+// Vose's method in integers: every column holds `total` units, split between
+// its own value and one alias, so the probabilities stay exact
+AliasTable::AliasTable(const vector<pair<int, int>>& weightedValues)
+  : keep(weightedValues.size()), alias(weightedValues.size()), total{0} {
+  const std::uint32_t columns = weightedValues.size();
+  vector<std::uint64_t> scaled;
+  for (const auto& [value, weight] : weightedValues) {
+    values.push_back(value);
+    scaled.push_back(static_cast<std::uint64_t>(weight) * columns);
+    total += weight;
+  }
+
+  vector<std::uint32_t> small, large;
+  for (std::uint32_t i = 0; i < columns; ++i) {
+    (scaled[i] < total ? small : large).push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    std::uint32_t under = small.back();
+    std::uint32_t over = large.back();
+    small.pop_back();
+    keep[under] = scaled[under];
+    alias[under] = over;
+    scaled[over] -= total - scaled[under];
+    if (scaled[over] < total) {
+      large.pop_back();
+      small.push_back(over);
+    }
+  }
+  // Whatever is left is full up to rounding and keeps its own value
+  for (std::uint32_t i : small) { keep[i] = total; alias[i] = i; }
+  for (std::uint32_t i : large) { keep[i] = total; alias[i] = i; }
+}
+
+// The high half of one draw picks the column and the low half flips the biased coin;
+// multiply-shift skews either by less than one part in 2^32 / columns
+int AliasTable::draw(Rng& rng) const {
+  const std::uint64_t bits = rng.next();
+  const std::uint32_t column = ((bits >> 32) * values.size()) >> 32;
+  const std::uint32_t coin = ((bits & 0xffffffffULL) * total) >> 32;
+  return values[coin < keep[column] ? column : alias[column]];
+}
+
+//----------------------------------
+// OUTPUT IMPLEMENTATION
+//----------------------------------
+
+namespace {
+  ConsoleSink consoleSink;
+  thread_local OutputSink* activeSink = &consoleSink;
+  thread_local bool activeSinkShown = true;
+}
+
+OutputSink& outputSink() {
+  return *activeSink;
+}
+
+void setOutputSink(OutputSink* sink) {
+  activeSink = sink ? sink : &consoleSink;
+  activeSinkShown = !activeSink->discards();
+}
+
+std::ostream& output() {
+  return activeSink->stream();
+}
+
+std::ostream& errorOutput() {
+  return activeSink->errorStream();
+}
+
+GameOutput gameOutput() {
+  return GameOutput{activeSinkShown ? &activeSink->stream() : nullptr};
+}
+
+BufferedSink::BlockBuffer::BlockBuffer(std::size_t capacity) : block(capacity) {
+  setp(block.data(), block.data() + block.size());
+}
+
+BufferedSink::BlockBuffer::int_type BufferedSink::BlockBuffer::overflow(int_type ch) {
+  drain();
+  if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+    sputc(traits_type::to_char_type(ch));
+  }
+  return traits_type::not_eof(ch);
+}
+
+// Hands everything collected so far to stdout in one write
+void BufferedSink::BlockBuffer::drain() {
+  std::size_t pending = pptr() - pbase();
+  if (pending > 0) {
+    std::fwrite(pbase(), 1, pending, stdout);
+    std::fflush(stdout);
+  }
+  setp(block.data(), block.data() + block.size());
+}
+
+BufferedSink::BufferedSink(std::size_t capacity) : buffer{capacity}, out{&buffer} {}
+
+BufferedSink::~BufferedSink() {
+  buffer.drain();
+  if (&outputSink() == this) {
+    setOutputSink(nullptr);
+  }
+}
+
+//----------------------------------
+// MEMORY IMPLEMENTATION
+//----------------------------------
+
+void* Arena::allocate(std::size_t size, std::size_t alignment) {
+  for (;;) {
+    if (current < blocks.size()) {
+      Block& block = blocks[current];
+      std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+      std::uintptr_t start = (base + used + alignment - 1) & ~(alignment - 1);
+      if (start + size <= base + block.size) {
+        used = start + size - base;
+        return reinterpret_cast<void*>(start);
+      }
+      ++current;
+      used = 0;
+      continue;
+    }
+    // Out of blocks; an oversized object gets a block of its own
+    std::size_t bytes = std::max(blockSize, size + alignment);
+    blocks.push_back({std::make_unique_for_overwrite<std::byte[]>(bytes), bytes});
   }
+}
 
-  // Seed the random number generator
-  static bool seeded = false;
-  if (!seeded) {
-    srand(time(nullptr));
-    seeded = true;
+void Arena::rewind(const Mark& mark) {
+  while (cleanups.size() > mark.cleanups) {
+    Cleanup cleanup = cleanups.back();
+    cleanups.pop_back();
+    cleanup.destroy(cleanup.object);
   }
+  current = mark.block;
+  used = mark.used;
+}
+
+std::size_t Arena::reserved() const {
+  std::size_t total = 0;
+  for (const Block& block : blocks) total += block.size;
+  return total;
+}
 
+//----------------------------------
+// DICE IMPLEMENTATION
+//----------------------------------
+
+Dice::Dice(bool testMode) : die1{0}, die2{0}, isTestMode{testMode} {}
+
+// Rolls two six-sided dice from the game's stream; test mode only adds setTestDice
+void Dice::roll(Rng& rng) {
   // Generate random numbers between 1 and 6
-  die1 = (rand() % 6) + 1;
-  die2 = (rand() % 6) + 1;
+  die1 = rng.uniform(6) + 1;
+  die2 = rng.uniform(6) + 1;
 }
 
 // Manually sets dice values
 void Dice::setTestDice(int d1, int d2) {
   if (!isTestMode) {
-    std::cerr << "Error: Cannot set test dice values when not in test mode." << std::endl;
+    errorOutput() << "Error: Cannot set test dice values when not in test mode." << std::endl;
     return;
   }
   die1 = d1;
@@ -84,2558 +307,4568 @@ bool Dice::isDoubles() const {
 
 
 //----------------------------------
-// PROPERTY IMPLEMENTATIONS
+// DECISION PROVIDER IMPLEMENTATIONS
 //----------------------------------
 
-Property::Property(string name, size_t location, size_t purchaseCost)
-  : Tile(name, location), purchaseCost(purchaseCost), mortgaged(false), owner(nullptr) {}
-
-Property::~Property() {}
+// Console answers keep the prompts' original y/n, 1/2 and accept/reject conventions;
+// the prompts themselves are printed by the rule code
+bool ConsoleDecisions::buyProperty(Player*, Property*) {
+  char answer = 'n';
+  cin >> answer;
+  return answer == 'y' || answer == 'Y';
+}
 
-size_t Property::getPurchaseCost() const {
-  return purchaseCost;
+bool ConsoleDecisions::payTuitionFlatFee(Player*, int, int) {
+  int choice = 0;
+  cin >> choice;
+  return choice == 1;
 }
 
-bool Property::isMortgaged() const {
-  return mortgaged;
+bool ConsoleDecisions::useTimsCup(Player*) {
+  char answer = 'n';
+  cin >> answer;
+  return answer == 'y' || answer == 'Y';
 }
 
-bool Property::mortgage() {
-  if (!owner || mortgaged) {
-    return false;
-  }
-  mortgaged = true;
-  return true;
+bool ConsoleDecisions::payToLeaveTims(Player*) {
+  char answer = 'n';
+  cin >> answer;
+  return answer == 'y' || answer == 'Y';
 }
 
-bool Property::unmortgage() {
-  if (!owner || !mortgaged) {
-    return false;
-  }
-  mortgaged = false;
-  return true;
+int ConsoleDecisions::chooseAssetToSell(Player*, int) {
+  // The menu is numbered from 1 and 0 cancels
+  int choice = 0;
+  cin >> choice;
+  return choice - 1;
 }
 
-void Property::setOwner(Player* newOwner) {
-  owner = newOwner;
+bool ConsoleDecisions::acceptTrade(Player*, const string&) {
+  string response;
+  cin >> response;
+  return response == "accept";
 }
 
-Player* Property::getOwner() const {
-  return owner;
+bool ConsoleDecisions::confirmBankruptcy(Player*) {
+  char answer = 'n';
+  cin >> answer;
+  return answer == 'y' || answer == 'Y';
 }
 
-void Property::landedOn(Player* player) {
-  if (!player) return;
-  
-  if (owner && owner != player && !mortgaged) {
-    // Player lands on a property owned by someone else
-    
-    // Check if it's a Gym and set the dice roll
-    Gym* gym = dynamic_cast<Gym*>(this);
-    if (gym) {
-      // Get the current dice total from the game
-      Game* gameInstance = Game::getInstance();
-      if (gameInstance) {
-        Dice& dice = gameInstance->getDice();
-        gym->setDiceRoll(dice.getTotal());
-      }
-    }
-    
-    int tuition = getTuition();
-    
-    cout << player->getName() << " landed on " << getName() 
-      << " owned by " << owner->getName() 
-      << " and must pay $" << tuition << endl;
-    
-    player->payMoney(tuition, owner);
-  }
-  else if (!owner) {
-    // Property is not owned, offer to buy it
-    cout << "Would you like to purchase " << getName() 
-      << " for $" << purchaseCost << "? (y/n): ";
-    
-    char answer;
-    cin >> answer;
-    
-    if (answer == 'y' || answer == 'Y') {
-      if (player->canPayAmount(purchaseCost)) {
-        player->buyProperty(this);
-      }
-      else {
-        cout << "Not enough money to purchase this property." << endl;
-      }
-    }
-    else {
-      // TODO: Trigger auction logic here via Game class -- not needed
-    }
-  }
+string ConsoleDecisions::chooseCreditor(Player*) {
+  string creditorName;
+  cin >> creditorName;
+  return creditorName;
 }
 
+int ConsoleDecisions::bid(Player*, Property*, int) {
+  string input;
+  cin >> input;
+  return utilities::isNumeric(input) ? stoi(input) : 0;
+}
 
+// People mortgage and improve with their own commands, so they are never asked here
+int ConsoleDecisions::chooseAssetToMortgage(Player*, int) {
+  return -1;
+}
 
-//----------------------------------
-// ACADEMIC BUILDING IMPLEMENTATIONS
-//----------------------------------
+AcademicBuilding* ConsoleDecisions::chooseImprovement(Player*) {
+  return nullptr;
+}
 
+bool ProgrammaticDecisions::buyProperty(Player* player, Property* property) {
+  if (onBuyProperty) return onBuyProperty(player, property);
+  return player->canPayAmount(property->getPurchaseCost());
+}
 
-AcademicBuilding::AcademicBuilding(string name, int position, int cost, int improvementCost, string block, vector<int> tuitionValues)
-  : Property(name, position, cost), tuitionBase(cost), improvementCost(improvementCost),
-    improvements(0), tuitionWithImprovements(tuitionValues), monopolyBlock(block) {}
+bool ProgrammaticDecisions::payTuitionFlatFee(Player* player, int flatFee, int percentFee) {
+  if (onPayTuitionFlatFee) return onPayTuitionFlatFee(player, flatFee, percentFee);
+  return flatFee <= percentFee;
+}
 
-int AcademicBuilding::getTuition() {
-  if (improvements < tuitionWithImprovements.size()) {
-    return tuitionWithImprovements[improvements];
-  } else {
-    return tuitionBase;
-  }
+bool ProgrammaticDecisions::useTimsCup(Player* player) {
+  if (onUseTimsCup) return onUseTimsCup(player);
+  return true;
 }
 
-bool AcademicBuilding::addImprovement() {
-  if (improvements < 5) { // Max of 5 improvements
-    improvements++;
-    return true;
-  }
+bool ProgrammaticDecisions::payToLeaveTims(Player* player) {
+  if (onPayToLeaveTims) return onPayToLeaveTims(player);
   return false;
 }
 
-bool AcademicBuilding::removeImprovement() {
-  if (improvements > 0) {
-    improvements--;
-    return true;
+// The first holding that is neither improved nor mortgaged, else the first one
+int ProgrammaticDecisions::chooseAssetToSell(Player* player, int amountOwed) {
+  if (onChooseAssetToSell) return onChooseAssetToSell(player, amountOwed);
+  const auto& properties = player->getProperties();
+  for (size_t i = 0; i < properties.size(); ++i) {
+    if (!utilities::isDeveloped(properties[i])) return i;
   }
+  return properties.empty() ? -1 : 0;
+}
+
+bool ProgrammaticDecisions::acceptTrade(Player* target, const string& offer) {
+  if (onAcceptTrade) return onAcceptTrade(target, offer);
   return false;
 }
 
-int AcademicBuilding::getImprovements() const {
-  return improvements;
+bool ProgrammaticDecisions::confirmBankruptcy(Player* player) {
+  if (onConfirmBankruptcy) return onConfirmBankruptcy(player);
+  return true;
 }
 
-int AcademicBuilding::getImprovementCost() const {
-  return improvementCost;
+string ProgrammaticDecisions::chooseCreditor(Player* player) {
+  if (onChooseCreditor) return onChooseCreditor(player);
+  return "bank";
 }
 
-string AcademicBuilding::getMonopolyBlock() const {
-  return monopolyBlock;
+int ProgrammaticDecisions::bid(Player* bidder, Property* property, int highestBid) {
+  if (onBid) return onBid(bidder, property, highestBid);
+  return 0;
 }
 
-bool AcademicBuilding::canMortgage() const {
-  return improvements == 0; // Can only mortgage if there are no improvements
+int ProgrammaticDecisions::chooseAssetToMortgage(Player* player, int amountOwed) {
+  if (onChooseAssetToMortgage) return onChooseAssetToMortgage(player, amountOwed);
+  return -1;
 }
 
-bool AcademicBuilding::mortgage() {
-  if (canMortgage()) {
-    // Perform mortgage logic
-    cout << "Mortgaging " << getName() << " at " << getPurchaseCost() / 2 << " money." << endl;
-    Property::mortgage();
-    return true;
+// Without a cash reserve rents never outgrow OSAP income and headless games do not finish
+AcademicBuilding* ProgrammaticDecisions::chooseImprovement(Player* player) {
+  if (onChooseImprovement) return onChooseImprovement(player);
+  const int reserve = 200;
+  const Board& board = player->getBoard();
+  for (std::uint64_t rest = player->getMonopolies() & ~board.getHoldings().mortgaged; rest; rest &= rest - 1) {
+    auto academic = static_cast<AcademicBuilding*>(board.getPropertyByBit(std::countr_zero(rest)));
+    if (academic->getImprovements() < 5 && player->getMoney() - academic->getImprovementCost() >= reserve) {
+      return academic;
+    }
   }
-  return false;
+  return nullptr;
 }
 
-//----------------------------------
-// RESIDENCE IMPLEMENTATION
-//----------------------------------
+ScriptedDecisions::ScriptedDecisions(deque<string> answers, DecisionProvider* fallback)
+  : answers{std::move(answers)}, fallback{fallback} {}
 
-Residence::Residence(std::string name, int position) 
-  : Property(name, position, 200) {}
+void ScriptedDecisions::push(const string& answer) {
+  answers.push_back(answer);
+}
 
-int Residence::getTuition() {
-  if (!getOwner()) {
-    return 0; // No rent if no owner
+bool ScriptedDecisions::next(string& answer) {
+  if (answers.empty()) {
+    return false;
   }
+  answer = std::move(answers.front());
+  answers.pop_front();
+  return true;
+}
 
-  // Count the number of residences the owner has
-  int numResidences = 0;
-  for (const Property* prop : getOwner()->getProperties()) {
-    if (dynamic_cast<const Residence*>(prop)) {
-      numResidences++;
-    }
+DecisionProvider& ScriptedDecisions::exhausted() {
+  if (!fallback) {
+    throw out_of_range("Scripted decisions ran out of answers");
   }
+  return *fallback;
+}
 
-  switch (numResidences) {
-    case 1: return 25;
-    case 2: return 50;
-    case 3: return 100;
-    case 4: return 200;
-    default: return 25;
-  }
+bool ScriptedDecisions::buyProperty(Player* player, Property* property) {
+  string answer;
+  if (!next(answer)) return exhausted().buyProperty(player, property);
+  return answer == "y" || answer == "Y";
 }
 
-//----------------------------------
-// GYM IMPLEMENTATION
-//----------------------------------
-Gym::Gym(std::string name, int position) 
-  : Property(name, position, 150), diceRoll(0) {}
+bool ScriptedDecisions::payTuitionFlatFee(Player* player, int flatFee, int percentFee) {
+  string answer;
+  if (!next(answer)) return exhausted().payTuitionFlatFee(player, flatFee, percentFee);
+  return answer == "1";
+}
 
-void Gym::setDiceRoll(int total) {
-  diceRoll = total;
+bool ScriptedDecisions::useTimsCup(Player* player) {
+  string answer;
+  if (!next(answer)) return exhausted().useTimsCup(player);
+  return answer == "y" || answer == "Y";
 }
 
-int Gym::getTuition() {
-  if (!getOwner() || diceRoll == 0) {
-    return 0; // No rent if unowned or dice not set
-  }
+bool ScriptedDecisions::payToLeaveTims(Player* player) {
+  string answer;
+  if (!next(answer)) return exhausted().payToLeaveTims(player);
+  return answer == "y" || answer == "Y";
+}
 
-  int numGymsOwned = 0;
-  for (const Property* prop : getOwner()->getProperties()) {
-    if (dynamic_cast<const Gym*>(prop)) {
-      numGymsOwned++;
-    }
-  }
+int ScriptedDecisions::chooseAssetToSell(Player* player, int amountOwed) {
+  string answer;
+  if (!next(answer)) return exhausted().chooseAssetToSell(player, amountOwed);
+  return utilities::isNumeric(answer) ? stoi(answer) - 1 : -1;
+}
 
-  // Determine the appropriate multiplier
-  int multiplier;
-  if (numGymsOwned == 2) {
-    multiplier = multiplierOwnedTwo;
-  } else {
-    multiplier = multiplierOwnedOne;
-  }
+bool ScriptedDecisions::acceptTrade(Player* target, const string& offer) {
+  string answer;
+  if (!next(answer)) return exhausted().acceptTrade(target, offer);
+  return answer == "accept";
+}
 
-  return diceRoll * multiplier;
+bool ScriptedDecisions::confirmBankruptcy(Player* player) {
+  string answer;
+  if (!next(answer)) return exhausted().confirmBankruptcy(player);
+  return answer == "y" || answer == "Y";
 }
 
-//----------------------------------
-// COLLECT OSAP IMPLEMENTATION
-//----------------------------------
-CollectOSAP::CollectOSAP(int position) 
-  : Tile("Collect OSAP", position) {}
+string ScriptedDecisions::chooseCreditor(Player* player) {
+  string answer;
+  if (!next(answer)) return exhausted().chooseCreditor(player);
+  return answer;
+}
 
-void CollectOSAP::landedOn(Player* player) {
-  // Award $200 for landing on or passing Collect OSAP
-  cout << "You landed on Collect OSAP. Receive $200" << endl;
-  player->receiveMoney(200);
+int ScriptedDecisions::bid(Player* bidder, Property* property, int highestBid) {
+  string answer;
+  if (!next(answer)) return exhausted().bid(bidder, property, highestBid);
+  return utilities::isNumeric(answer) ? stoi(answer) : 0;
 }
 
-//----------------------------------
-// COOP FEE IMPLEMENTATION
-//----------------------------------
-CoopFee::CoopFee(int position) 
-  : Tile("Coop Fee", position) {}
+int ScriptedDecisions::chooseAssetToMortgage(Player* player, int amountOwed) {
+  string answer;
+  if (!next(answer)) return exhausted().chooseAssetToMortgage(player, amountOwed);
+  return utilities::isNumeric(answer) ? stoi(answer) - 1 : -1;
+}
 
-void CoopFee::landedOn(Player* player) {
-  const int feeAmount = 150;  // Fixed $150 fee as per requirements
+AcademicBuilding* ScriptedDecisions::chooseImprovement(Player*) {
+  return nullptr;
+}
 
-  Game* gameInstance = Game::getInstance();
-  Bank& bank = gameInstance->getBank();
-  
-  cout << "You landed on Coop Fee. You must pay $" << feeAmount << endl;
-  
-  player->payMoneyToBank(feeAmount, bank);
-    // If player can't pay, handle bankruptcy 
+vector<string> RecordingDecisions::take() {
+  vector<string> taken;
+  taken.swap(answers);
+  return taken;
 }
 
-//----------------------------------
-// GO TO TIMS IMPLEMENTATION
-//----------------------------------
-GoToTims::GoToTims(int position) 
-  : Tile("Go To Tims", position) {}
+bool RecordingDecisions::buyProperty(Player* player, Property* property) {
+  bool answer = inner->buyProperty(player, property);
+  answers.push_back(answer ? "y" : "n");
+  return answer;
+}
 
-void GoToTims::landedOn(Player* player) {
-  cout << "You landed on Go To Tims. Moving to DC Tims Line!" << endl;
-  
-  // Directly send player to DC Tims Line (position 10)
-  player->teleport(10);
-  player->enterTimsLine();
-  
-  cout << player->getName() << " is now in the DC Tims Line." << endl;
+bool RecordingDecisions::payTuitionFlatFee(Player* player, int flatFee, int percentFee) {
+  bool answer = inner->payTuitionFlatFee(player, flatFee, percentFee);
+  answers.push_back(answer ? "1" : "2");
+  return answer;
 }
 
-//----------------------------------
-// TIMS LINE IMPLEMENTATION
-//----------------------------------
-TimsLine::TimsLine(int position) 
-  : Tile("DC Tims Line", position) {}
+bool RecordingDecisions::useTimsCup(Player* player) {
+  bool answer = inner->useTimsCup(player);
+  answers.push_back(answer ? "y" : "n");
+  return answer;
+}
 
-void TimsLine::landedOn(Player* player) {
-  if (!player) return;
-  
-  cout << player->getName() << " has landed on DC Tims Line." << endl;
-  cout << "This is just visiting - no effect." << endl;
-  // No effect if just visiting
+bool RecordingDecisions::payToLeaveTims(Player* player) {
+  bool answer = inner->payToLeaveTims(player);
+  answers.push_back(answer ? "y" : "n");
+  return answer;
 }
 
-//----------------------------------
-// NEEDLES HALL IMPLEMENTATION
-//----------------------------------
-NeedlesHall::NeedlesHall(int position) : Tile("Needles Hall", position) {
-  money_changes = {
-    {-200, 1.0/18},  // Lose $200
-    {-100, 1.0/9},   // Lose $100
-    {-50,  1.0/6},   // Lose $50
-    {25,   1.0/3},   // Gain $25
-    {50,   1.0/6},   // Gain $50
-    {100,  1.0/9},   // Gain $100
-    {200,  1.0/18}   // Gain $200
-  };
+int RecordingDecisions::chooseAssetToSell(Player* player, int amountOwed) {
+  int answer = inner->chooseAssetToSell(player, amountOwed);
+  answers.push_back(to_string(answer + 1)); // the menu is numbered from 1, 0 cancels
+  return answer;
 }
 
-void NeedlesHall::landedOn(Player* player) {
-  cout << player->getName() <<" landed on Needles Hall!" << endl;
+bool RecordingDecisions::acceptTrade(Player* target, const string& offer) {
+  bool answer = inner->acceptTrade(target, offer);
+  answers.push_back(answer ? "accept" : "reject");
+  return answer;
+}
 
-  static std::default_random_engine engine(std::random_device{}());
-  std::vector<double> weights;
-  for (const auto& [amount, prob] : money_changes) {
-    weights.push_back(prob);
-  }
-  
-  std::discrete_distribution<int> dist(weights.begin(), weights.end());
-  int selected = dist(engine);
-  int amount = money_changes[selected].first;
+bool RecordingDecisions::confirmBankruptcy(Player* player) {
+  bool answer = inner->confirmBankruptcy(player);
+  answers.push_back(answer ? "y" : "n");
+  return answer;
+}
 
-  if (amount > 0) {
-    cout << "You received $" << amount << "!" << endl;
-    player->receiveMoney(amount);
-  } else {
-    cout << "You must pay $" << -amount << "." << endl;
-    player->receiveMoney(amount);
-    // if (!success) {
-    //     cout << "You cannot pay and must declare bankruptcy or raise funds." << endl;
-    // }
-  }
-
-  // 1% chance to get a Roll Up the Rim cup
-  std::bernoulli_distribution cupDist(0.01);
-  if (cupDist(engine)) {
-    player->addTimsCup();
-  }
+string RecordingDecisions::chooseCreditor(Player* player) {
+  string answer = inner->chooseCreditor(player);
+  answers.push_back(answer);
+  return answer;
 }
 
-//----------------------------------
-// SLC 
-//----------------------------------
-SLC::SLC(int position) : Tile("SLC", position) {
-  movements = {
-    {-3, 1.0/8}, 
-    {-2, 1.0/6}, 
-    {-1, 1.0/6},
-    {1, 1.0/8}, 
-    {2, 1.0/6}, 
-    {3, 1.0/6},
-    {10, 1.0/24}, 
-    {0, 1.0/24}
-  };
+int RecordingDecisions::bid(Player* bidder, Property* property, int highestBid) {
+  int answer = inner->bid(bidder, property, highestBid);
+  answers.push_back(to_string(answer));
+  return answer;
 }
 
-void SLC::landedOn(Player* player) {
-  cout << "You landed on SLC (Student Life Centre)!" << endl;
-  
-  static std::default_random_engine engine(std::random_device{}());
-  std::vector<double> weights;
-  for (const auto& [move, prob] : movements) weights.push_back(prob);
-  std::discrete_distribution<int> dist(weights.begin(), weights.end());
-
-  int selected = dist(engine);
-  int move = movements[selected].first;
+int RecordingDecisions::chooseAssetToMortgage(Player* player, int amountOwed) {
+  int answer = inner->chooseAssetToMortgage(player, amountOwed);
+  answers.push_back(to_string(answer + 1)); // numbered like the sale menu
+  return answer;
+}
 
-  // Try to get the board from the Game instance
-  Game* gameInstance = Game::getInstance();
-  Board* board = nullptr;
-  if (gameInstance) {
-    board = &(gameInstance->getBoard());
-  }
-  
-  if (move == 10) {
-    cout << "The card sends you to DC Tims Line!" << endl;
-    // Send to Tims Line
-    if (board) {
-      board->sendToTimsLine(player);
-    } else {
-      player->teleport(10);
-      player->enterTimsLine();
-    }
-  } else if (move == 0) {
-    cout << "The card sends you to Collect OSAP!" << endl;
-    // Go to Collect OSAP
-    player->teleport(0);
-    
-    // Since we're moving to Collect OSAP, we should also give $200
-    player->receiveMoney(200);
-    cout << "You collect $200 for passing OSAP." << endl;
-  } else {
-    if (move > 0) {
-      cout << "The card moves you forward " << move << " spaces." << endl;
-    } else {
-      cout << "The card moves you backward " << -move << " spaces." << endl;
-    }
-    
-    // Move forward/backward
-    player->move(move);
-  }
+AcademicBuilding* RecordingDecisions::chooseImprovement(Player* player) {
+  return inner->chooseImprovement(player);
+}
 
-  // 1% chance to get a Roll Up the Rim cup
-  std::bernoulli_distribution cupDist(0.01);
-  if (cupDist(engine)) {
-    player->addTimsCup();
+DecisionProvider& SeatedDecisions::of(const Player* player) {
+  int seat = game.getSeat(player);
+  if (seat < 0 || bySeat.empty()) {
+    throw logic_error("No decision provider for " + player->getName());
   }
+  return *bySeat[seat % bySeat.size()];
 }
 
-//----------------------------------
-// TUITION
-//----------------------------------
-Tuition::Tuition(int position) : Tile("Tuition", position) {}
-
-void Tuition::landedOn(Player* player) {
-  cout << "You landed on Tuition!" << endl;
-  
-  Game* gameInstance = Game::getInstance();
-  Bank& bank = gameInstance->getBank();
+bool SeatedDecisions::buyProperty(Player* player, Property* property) {
+  return of(player).buyProperty(player, property);
+}
 
-  // Calculate 10% of total worth
-  const int totalWorth = player->getNetWorth();
-  const int tenPercent = static_cast<int>(totalWorth * 0.1);
-  const int flatFee = 300;
+bool SeatedDecisions::payTuitionFlatFee(Player* player, int flatFee, int percentFee) {
+  return of(player).payTuitionFlatFee(player, flatFee, percentFee);
+}
 
-  // Display options to the player
-  std::cout << "Tuition options:" << std::endl;
-  std::cout << "1. Pay $" << flatFee << " flat fee" << std::endl;
-  std::cout << "2. Pay $" << tenPercent << " (one 10th of your total worth)" << std::endl;
-  std::cout << "Enter choice (1 or 2): ";
-  
-  int choice;
-  std::cin >> choice;
-  
-  if (choice == 1) {
-    // Player chose to pay flat fee
-    cout << "You paid the flat fee of $" << flatFee << "." << endl;
-    bool success = player->payMoneyToBank(flatFee, bank); // <- here 
-    if (!success) {
-      cout << "You cannot pay tuition and must declare bankruptcy or raise funds." << endl;
-    }
-  } else {
-    // Player chose to pay percentage
-    cout << "You paid one 10th of your worth: $" << tenPercent << "." << endl;
-    bool success = player->payMoneyToBank(tenPercent, bank); // <- here 
-    if (!success) {
-      cout << "You cannot pay tuition and must declare bankruptcy or raise funds." << endl;
-    }
-  }
+bool SeatedDecisions::useTimsCup(Player* player) {
+  return of(player).useTimsCup(player);
 }
 
-//----------------------------------
-// GOOSE NESTING
-//----------------------------------
-GooseNesting::GooseNesting(int position) 
-  : Tile("Goose Nesting", position) {}
+bool SeatedDecisions::payToLeaveTims(Player* player) {
+  return of(player).payToLeaveTims(player);
+}
 
-void GooseNesting::landedOn(Player* player) {
-  cout << "You landed on Goose Nesting!" << endl;
-  
-  static std::default_random_engine engine(std::random_device{}());
-  std::uniform_int_distribution<int> dist(0, gooseMessages.size() - 1);
-  
-  // Display random goose encounter message
-  std::string message = gooseMessages[dist(engine)];
-  std::cout << message << std::endl;
-  
-  // No game effect occurs (no money lost, no movement)
-  cout << "Fortunately, you escaped without any monetary damage." << endl;
+int SeatedDecisions::chooseAssetToSell(Player* player, int amountOwed) {
+  return of(player).chooseAssetToSell(player, amountOwed);
 }
 
-//----------------------------------
-// PLAYER IMPLEMENTATIONS
-//----------------------------------
-Player::Player(std::string name, char piece) : 
-  name{name}, 
-  piece{piece}, 
-  money{1500}, 
-  position{0}, 
-  inTimsLine{false}, 
-  turnsInTimsLine{0}, 
-  timsCups{0}, 
-  properties{} // Initialize empty vector of Property pointers
-{
+bool SeatedDecisions::acceptTrade(Player* target, const string& offer) {
+  return of(target).acceptTrade(target, offer);
 }
 
+bool SeatedDecisions::confirmBankruptcy(Player* player) {
+  return of(player).confirmBankruptcy(player);
+}
 
-void Player::move(int steps){
+string SeatedDecisions::chooseCreditor(Player* player) {
+  return of(player).chooseCreditor(player);
+}
 
-if(steps < 0){
-  int tmp = position + steps;
-  if (tmp < 0){
-    tmp = 40 + tmp ;
-  }
-  position = tmp;
-  return;
+int SeatedDecisions::bid(Player* bidder, Property* property, int highestBid) {
+  return of(bidder).bid(bidder, property, highestBid);
 }
 
-int tmp = (position + steps) % 40;
-if(tmp < position){
-  receiveMoney(200);
-  position = tmp;
+int SeatedDecisions::chooseAssetToMortgage(Player* player, int amountOwed) {
+  return of(player).chooseAssetToMortgage(player, amountOwed);
 }
-position = tmp;
-return;
+
+AcademicBuilding* SeatedDecisions::chooseImprovement(Player* player) {
+  return of(player).chooseImprovement(player);
 }
 
-void Player::teleport(int destination){
+//----------------------------------
+// STRATEGIES
+//----------------------------------
 
-position = destination;
-return;
+namespace {
+  // Buys only while keeping a cushion for rent, and never pays its way out of Tims Line
+  std::unique_ptr<DecisionProvider> frugalStrategy() {
+    auto frugal = std::make_unique<ProgrammaticDecisions>();
+    frugal->onBuyProperty = [](Player* player, Property* property) {
+      return player->canPayAmount(property->getPurchaseCost() + 300);
+    };
+    return frugal;
+  }
 }
 
-bool Player::payMoney(int amount, Player* recipient) {
-  // If we can't afford it, allow the player to sell properties
-  if(!canPayAmount(amount)) {
-    cout << "You DO NOT have the cash to continue, you must sell some property to continue. Press c:";
-    char type;
-    do {
-      cin >> type;
-    } while(!cin.fail() && type != 'c');
-    
-    if(type == 'c') {
-      // Display available properties
-      if(properties.empty()) {
-        cout << "You don't have any properties to sell." << endl;
-        declaredBankruptcy(recipient);
-        
-        // Notify the game that this player has gone bankrupt
-        Game* gameInstance = Game::getInstance();
-        if (gameInstance) {
-          cout << "Player " << name << " has left the game due to bankruptcy." << endl;
-          gameInstance->removeBankruptPlayer(this);
-        }
-        
-        return false;
-      }
-      
-      cout << "Available properties:" << endl;
-      for(size_t i = 0; i < properties.size(); i++) {
-        cout << i + 1 << ": " << properties[i]->getName();
-        if(properties[i]->isMortgaged()) {
-          cout << " (mortgaged)";
-        }
-        cout << " - Worth $" << properties[i]->getPurchaseCost() / 2 << endl;
-      }
-      
-      // Let player choose a property
-      int choice;
-      cout << "Enter property number (0 to cancel): ";
-      cin >> choice;
-      
-      if(choice <= 0 || choice > static_cast<int>(properties.size())) {
-        cout << "Sale canceled." << endl;
-        return false;
+std::unique_ptr<DecisionProvider> makeStrategy(const string& name, const Game& game, unsigned searchThreads) {
+  if (name == "mcts" || name.rfind("mcts:", 0) == 0) {
+    MctsConfig config;
+    config.threads = searchThreads;
+    if (name.size() > 5) {
+      // A fixed rollout count plays the same way however fast the machine is
+      if (!utilities::isNumeric(name.substr(5)) || stoi(name.substr(5)) <= 0) {
+        throw invalid_argument("Bad rollout count in " + name);
       }
-      
-      // Sell the chosen property
-      Property* propertyToSell = properties[choice - 1];
-      sellProperty(propertyToSell);
-      cout << "Sold " << propertyToSell->getName() << " to the bank for $" 
-         << propertyToSell->getPurchaseCost() / 2 << endl;
-      
-      // Recursively try to pay again
-      return payMoney(amount, recipient);
+      config.rollouts = stoi(name.substr(5));
+      config.milliseconds = 0;
     }
+    return std::make_unique<MctsBot>(game, config);
   }
+  if (name == "default") return std::make_unique<ProgrammaticDecisions>();
+  if (name == "frugal") return frugalStrategy();
+  if (name == "buy-everything") return std::make_unique<BuyEverythingBot>();
+  if (name == "monopoly") return std::make_unique<MonopolyBot>();
+  if (name == "hoarder") return std::make_unique<CashHoarderBot>();
+  throw invalid_argument("Unknown strategy " + name);
+}
 
-  // Double-check that we have enough money
-  if(money - amount < 0) {
-    int netWorth = getNetWorth();
-    return false;
-  }
+vector<string> strategyNames() {
+  return {"default", "frugal", "buy-everything", "monopoly", "hoarder", "mcts"};
+}
 
-  // Process the payment
-  money = money - amount;
-  if(recipient) {
-    recipient->receiveMoney(amount);
-  }
-  return true;
+bool isStrategy(const string& name) {
+  vector<string> names = strategyNames();
+  string base = name.substr(0, name.find(':'));
+  if (base != name && base != "mcts") return false;
+  return std::find(names.begin(), names.end(), base) != names.end();
 }
 
-bool Player::payMoneyToBank(int amount, Bank& recipient) {
-  // If we can't afford it, allow the player to sell properties
-  if(!canPayAmount(amount)) {
-    cout << "You DO NOT have the cash to continue, you must sell some property to continue. Press c:";
-    char type;
-    do {
-      cin >> type;
-    } while(!cin.fail() && type != 'c');
-    
-    if(type == 'c') {
-      // Display available properties
-      if(properties.empty()) {
-        cout << "You don't have any properties to sell." << endl;
-        declaredBankruptcy(nullptr); // nullptr because we're paying the bank
-        
-        // Notify the game that this player has gone bankrupt
-        Game* gameInstance = Game::getInstance();
-        if (gameInstance) {
-          cout << "Player " << name << " has left the game due to bankruptcy." << endl;
-          gameInstance->removeBankruptPlayer(this);
-        }
-        
-        return false;
-      }
-      
-      cout << "Available properties:" << endl;
-      for(size_t i = 0; i < properties.size(); i++) {
-        cout << i + 1 << ": " << properties[i]->getName();
-        if(properties[i]->isMortgaged()) {
-          cout << " (mortgaged)";
-        }
-        cout << " - Worth $" << properties[i]->getPurchaseCost() / 2 << endl;
-      }
-      
-      // Let player choose a property
-      int choice;
-      cout << "Enter property number (0 to cancel): ";
-      cin >> choice;
-      
-      if(choice <= 0 || choice > static_cast<int>(properties.size())) {
-        cout << "Sale canceled." << endl;
-        return false;
-      }
-      
-      // Sell the chosen property
-      Property* propertyToSell = properties[choice - 1];
-      sellProperty(propertyToSell);
-      cout << "Sold " << propertyToSell->getName() << " to the bank for $" 
-         << propertyToSell->getPurchaseCost() / 2 << endl;
-      
-      // Recursively try to pay again
-      return payMoneyToBank(amount, recipient);
-    }
-  }
+//----------------------------------
+// BOTS
+//----------------------------------
 
-  // Double-check that we have enough money
-  if(money - amount < 0) {
-    int netWorth = getNetWorth();
-    return false;
-  }
+bool Bot::affords(const Player* player, int cost) const {
+  return player->getMoney() - cost >= reserve;
+}
 
-  // Process the payment
-  money = money - amount;
-  recipient.collectMoney(amount);
-  return true;
+int Bot::valueOf(Player*, Property* property) {
+  return property->getPurchaseCost();
 }
 
-// Adds money to the player's balance
-void Player::receiveMoney(int amount) {
-  money += amount;
+bool Bot::buyProperty(Player* player, Property* property) {
+  int cost = property->getPurchaseCost();
+  return valueOf(player, property) >= cost && affords(player, cost);
+}
+
+bool Bot::payTuitionFlatFee(Player*, int flatFee, int percentFee) {
+  return flatFee <= percentFee;
 }
 
-// Sells a property
-void Player::sellProperty(Property* property) {
-  auto it = find(properties.begin(), properties.end(), property);
+bool Bot::useTimsCup(Player*) {
+  return true;
+}
 
-  if (it != properties.end()) {
-    receiveMoney(property->getPurchaseCost() / 2); // Selling to bank at half price
-    properties.erase(it);
-    property->setOwner(nullptr);
-  }
+bool Bot::payToLeaveTims(Player* player) {
+  return affords(player, 50);
 }
 
-// Mortgages a property for half its purchase price
-bool Player::mortgageProperty(Property* property) {
-  if (!property->isMortgaged()) {
-    receiveMoney(property->getPurchaseCost() / 2);
-    property->mortgage();
-    return true;
+// The cheapest holding earns the least rent; improved or mortgaged ones go last
+int Bot::chooseAssetToSell(Player* player, int) {
+  const auto& properties = player->getProperties();
+  int cheapest = -1;
+  for (size_t i = 0; i < properties.size(); ++i) {
+    bool developed = utilities::isDeveloped(properties[i]);
+    bool cheapestDeveloped = cheapest >= 0 && utilities::isDeveloped(properties[cheapest]);
+    if (cheapest < 0 || (cheapestDeveloped && !developed) ||
+        (cheapestDeveloped == developed &&
+         properties[i]->getPurchaseCost() < properties[cheapest]->getPurchaseCost())) {
+      cheapest = i;
+    }
   }
-  return false;
+  return cheapest;
 }
 
-// Unmortgages a property by paying back half its purchase price
-bool Player::unmortgageProperty(Property* property) {
-
-Game* gameInstance = Game::getInstance();
-Bank& bank = gameInstance->getBank();
+bool Bot::acceptTrade(Player*, const string&) {
+  return false;
+}
 
-if (property->isMortgaged()) {
-    payMoneyToBank(property->getPurchaseCost() / 2, bank);
-    property->unmortgage();
-    return true;
+bool Bot::confirmBankruptcy(Player*) {
+  return true;
 }
-return false;
+
+string Bot::chooseCreditor(Player*) {
+  return "bank";
 }
 
-// Checks if the player has enough money to cover an amount
-bool Player::canPayAmount(int amount) {
-  return money >= amount;
+// Raises the bid in $10 steps while it stays within both value and reserve
+int Bot::bid(Player* bidder, Property* property, int highestBid) {
+  int limit = std::min(valueOf(bidder, property), bidder->getMoney() - reserve);
+  return highestBid + 10 <= limit ? highestBid + 10 : 0;
 }
 
-// Calculates total net worth
-int Player::getNetWorth() {
-  int total = money;
-  for (const auto& property : properties) {
-    total += property->getPurchaseCost();
-    if (auto academic = dynamic_cast<AcademicBuilding*>(property)) {
-      total += academic->getImprovements() * academic->getImprovementCost();
+// Cheapest unimproved holding, keeping monopolies whole for as long as possible
+int Bot::chooseAssetToMortgage(Player* player, int) {
+  const auto& properties = player->getProperties();
+  int choice = -1;
+  bool choiceInMonopoly = false;
+  for (size_t i = 0; i < properties.size(); ++i) {
+    Property* property = properties[i];
+    AcademicBuilding* academic = asAcademicBuilding(property);
+    if (property->isMortgaged() || (academic && academic->getImprovements() > 0)) {
+      continue;
+    }
+    bool inMonopoly = academic && player->ownsMonopoly(academic);
+    if (choice < 0 || (choiceInMonopoly && !inMonopoly) ||
+        (inMonopoly == choiceInMonopoly && property->getPurchaseCost() < properties[choice]->getPurchaseCost())) {
+      choice = i;
+      choiceInMonopoly = inMonopoly;
     }
   }
-  return total;
+  return choice;
 }
 
-// Declares bankruptcy
-void Player::declaredBankruptcy(Player* creditor) {
-  if (creditor) {
-    for (auto* property : properties) {
-      creditor->properties.push_back(property);
-      property->setOwner(creditor);
+// Builds evenly: the least improved building it can afford
+AcademicBuilding* Bot::chooseImprovement(Player* player) {
+  AcademicBuilding* choice = nullptr;
+  const Board& board = player->getBoard();
+  for (std::uint64_t rest = player->getMonopolies() & ~board.getHoldings().mortgaged; rest; rest &= rest - 1) {
+    auto academic = static_cast<AcademicBuilding*>(board.getPropertyByBit(std::countr_zero(rest)));
+    if (academic->getImprovements() >= 5 || !affords(player, academic->getImprovementCost())) {
+      continue;
+    }
+    if (!choice || academic->getImprovements() < choice->getImprovements()) {
+      choice = academic;
     }
   }
-  properties.clear();
-  money = 0;
-  cout << name << " has declared bankruptcy!" << endl;
+  return choice;
 }
 
-// Sends player to the Tim's Line
-void Player::enterTimsLine() {
-  inTimsLine = true;
-  turnsInTimsLine = 0;
+int MonopolyBot::valueOf(Player* player, Property* property) {
+  int cost = property->getPurchaseCost();
+  if (AcademicBuilding* academic = asAcademicBuilding(property)) {
+    int owned = player->getOwnedInBlock(academic->getBlockId());
+    if (owned + 1 == academic->getBlockSize()) return cost * 2;
+    if (owned > 0) return cost * 3 / 2;
+    return cost;
+  }
+  return property->getKind() == TileKind::Gym ? cost / 2 : cost;
 }
 
-// Releases player from Tim's Line
-void Player::leaveTimsLine() {
-  inTimsLine = false;
-  turnsInTimsLine = 0;
+int CashHoarderBot::valueOf(Player*, Property* property) {
+  return property->getPurchaseCost() / 2;
 }
 
-// Adds a Tim's Cup
-void Player::addTimsCup() {
-  Game* gameInstance = Game::getInstance();
-  if(gameInstance && gameInstance->canGiveMoreCups()) {
-    timsCups++;
-    gameInstance->currentTimsCupsInGame++; 
-    cout << "Congratulations! You received a Roll Up the Rim cup!" << endl;
-  }
+bool CashHoarderBot::buyProperty(Player* player, Property* property) {
+  int cost = property->getPurchaseCost();
+  return cost * 4 <= player->getMoney() && affords(player, cost);
 }
 
-// Uses a Tim's Cup to escape from Tim's Line
-bool Player::useTimsCup() {
-  if (timsCups > 0) {
-    timsCups--;
-    leaveTimsLine();
-    return true;
-  }
+bool CashHoarderBot::payToLeaveTims(Player*) {
   return false;
 }
 
-// Helper method needed by CommandInterpreter
-void Player::incrementTurnsInTimsLine() {
-  turnsInTimsLine++;
-}
+//----------------------------------
+// PROPERTY IMPLEMENTATIONS
+//----------------------------------
 
-bool Player::ownsMonopoly(std::string blockName) {
-  // Count properties in this monopoly block that the player owns
-  int ownedInBlock = 0;
-  int totalInBlock = 0;
-  
-  // Look at player's own properties to count ones in this block
-  for (const auto& prop : properties) {
-    AcademicBuilding* academic = dynamic_cast<AcademicBuilding*>(prop);
-    if (academic && academic->getMonopolyBlock() == blockName) {
-      ownedInBlock++;
-    }
-  }
-  
-  // If we don't own any in the block, return early
-  if (ownedInBlock == 0) {
-    return false;
-  }
-  
-  // We need to check how many properties are in this monopoly block total
-  // This could be hard-coded based on the game rules
-  if (blockName == "Arts1" || blockName == "Sci1") {
-    totalInBlock = 2; // AL+ML or PHYS+B1+B2
-  } else if (blockName == "Arts2" || blockName == "Eng" || blockName == "Health" || 
-       blockName == "Env" || blockName == "Sci2" || blockName == "Math") {
-    totalInBlock = 3; // ECH+PAS+HH, RCH+DWE+CPH, etc.
-  } else {
-    // Unknown block
-    return false;
-  }
-  
-  // Player has monopoly if they own all properties in the block
-  return ownedInBlock == totalInBlock;
+Property::Property(string name, size_t location, size_t purchaseCost, TileKind kind)
+  : Tile(name, location, kind), purchaseCost(purchaseCost), owner(nullptr) {}
+
+Property::~Property() {}
+
+size_t Property::getPurchaseCost() const {
+  return purchaseCost;
 }
 
-bool Player::buyProperty(Property* property) {
-  // Validate the property
-  if (!property) {
-    std::cerr << "Invalid property." << std::endl;
-    return false;
-  }
+bool Property::isMortgaged() const {
+  return holdings->mortgaged & getMask();
+}
 
-  // Check if property is already owned
-  if (property->getOwner()) {
-    std::cout << "Property already owned by " << property->getOwner()->getName() << std::endl;
+bool Property::mortgage() {
+  if (!owner || isMortgaged()) {
     return false;
   }
+  setMortgaged(true);
+  return true;
+}
 
-  // Check if player has enough money
-  int cost = property->getPurchaseCost();
-  if (money < cost) {
-    std::cout << "Not enough money to buy property." << std::endl;
+bool Property::unmortgage() {
+  if (!owner || !isMortgaged()) {
     return false;
   }
+  setMortgaged(false);
+  return true;
+}
 
-  // Process purchase
-  money -= cost;
-  property->setOwner(this);
-  properties.push_back(property);
-  
-  std::cout << name << " purchased " << property->getName() << " for $" << cost << std::endl;
-  return true;
-}
-
-bool Player::buyImprovement(AcademicBuilding* property) {
-  // Validate the property
-  if (!property) {
-    std::cerr << "Invalid property." << std::endl;
-    return false;
-  }
-
-  // Check if player owns the property
-  if (property->getOwner() != this) {
-    std::cout << "You don't own this property." << std::endl;
-    return false;
-  }
-
-  // Check if player has monopoly on this block
-  if (!ownsMonopoly(property->getMonopolyBlock())) {
-    std::cout << "You need to own all properties in the " << property->getMonopolyBlock() << " block to buy improvements." << std::endl;
-    return false;
-  }
-
-  // Check if property already has maximum improvements
-  if (property->getImprovements() >= 5) {
-    std::cout << "This property already has maximum improvements." << std::endl;
-    return false;
-  }
-
-  // Check if player has enough money
-  int cost = property->getImprovementCost();
-  if (money < cost) {
-    std::cout << "Not enough money to buy improvement." << std::endl;
-    return false;
-  }
-
-  // Process improvement purchase
-  if (!property->addImprovement()) {
-    std::cout << "Failed to add improvement." << std::endl;
-    return false;
-  }
-
-  money -= cost;
-  std::cout << name << " bought an improvement on " << property->getName() << " for $" << cost << std::endl;
-  return true;
+void Property::setOwner(Player* newOwner) {
+  owner = newOwner;
 }
 
-void Player::tradePropertyInsteadOfPaying(Property* property, Player* recipient) {
-  // Implementation pending
+Player* Property::getOwner() const {
+  return owner;
 }
 
-std::string Player::getAssets() {
-  std::stringstream ss;
-  ss << "Cash: $" << money << std::endl;
-  ss << "Properties:" << std::endl;
-  for (const auto& property : properties) {
-    ss << "- " << property->getName();
-    if (property->isMortgaged()) {
-      ss << " (mortgaged)";
-    }
-    ss << std::endl;
+void Property::setMortgaged(bool isMortgaged) {
+  if (isMortgaged) {
+    holdings->mortgaged |= getMask();
+  } else {
+    holdings->mortgaged &= ~getMask();
   }
-  ss << "Tim's Cups: " << timsCups << std::endl;
-  return ss.str();
 }
 
-bool Player::sellImprovement(AcademicBuilding* property) {
-  if (!property) {
-    std::cerr << "Invalid property." << std::endl;
-    return false;
-  }
-  
-  if (property->getOwner() != this) {
-    std::cout << "You don't own this property." << std::endl;
-    return false;
-  }
-  
-  if (property->getImprovements() <= 0) {
-    std::cout << "This property has no improvements to sell." << std::endl;
-    return false;
-  }
-  
-  // Process selling
-  if (!property->removeImprovement()) {
-    std::cout << "Failed to remove improvement." << std::endl;
-    return false;
-  }
-  
-  // Calculate half the price
-  int refund = property->getImprovementCost() / 2;
-  receiveMoney(refund);
-  
-  std::cout << name << " sold an improvement on " << property->getName() 
-        << " for $" << refund << std::endl;
-  return true;
+void Property::placeOn(Holdings* holdings, int bit) {
+  this->holdings = holdings;
+  this->bit = bit;
 }
 
-//----------------------------------
-// BOARD IMPLEMENTATIONS
-//----------------------------------
-
-Board::Board(){
-initializeBoard(); 
+void Property::reset() {
+  owner = nullptr;
+  setMortgaged(false);
 }
 
-void Board::initializeBoard() {
-  // First, read property data from CSV file
-  map<string, tuple<string, int, int, vector<int>>> propertyData;
+void Property::landedOn(Game& game, Player* player) {
+  if (!player) return;
   
-  ifstream csv{"watopoly_data.csv"};
-  if (csv.is_open()) {
-    string line;
-    // Skip header row
-    getline(csv, line);
+  if (owner && owner != player && !isMortgaged()) {
+    // Player lands on a property owned by someone else
     
-    while (getline(csv, line)) {
-      stringstream ss(line);
-      string item;
-      vector<string> row;
-      
-      while (getline(ss, item, ',')) {
-        row.push_back(item);
-      }
-      
-      if (row.size() >= 10) { // Ensure we have enough columns
-        string name = row[0];
-        string block = row[1];
-        int purchaseCost = stoi(row[2]);
-        int improvementCost = stoi(row[3]);
-        
-        // Parse tuition values (columns 4-9 are the tuition values for 0-5 improvements)
-        vector<int> tuitionValues;
-        for (size_t i = 4; i < 10; ++i) {
-          tuitionValues.push_back(stoi(row[i]));
-        }
-        
-        propertyData[name] = make_tuple(block, purchaseCost, improvementCost, tuitionValues);
-      }
+    // Check if it's a Gym and set the dice roll
+    if (getKind() == TileKind::Gym) {
+      // Get the current dice total from the game
+      static_cast<Gym*>(this)->setDiceRoll(game.getDice().getTotal());
     }
-    csv.close();
-  } else {
-    cerr << "Warning: Could not open watopoly_data.csv, using default values" << endl;
-  }
-
-  // Now read the board layout
-  ifstream file{"boardTileOrder.txt"};
-  string line;
-  if (!file.is_open()) {
-    cerr << "Error: Unable to open boardTileOrder.txt" << endl;
-    return;
-  }
-
-  int i = 0;
-  while (getline(file, line)) {
-    Tile* newTile = nullptr;
     
-    // Trim any whitespace from the line
-    line.erase(0, line.find_first_not_of(" \t\r\n"));
-    line.erase(line.find_last_not_of(" \t\r\n") + 1);
+    int tuition = getTuition();
     
-    // Debug: Print the tile being created -- not needed anymore
+    gameOutput() << player->getName() << " landed on " << getName() 
+      << " owned by " << owner->getName() 
+      << " and must pay $" << tuition << endl;
     
-    // Special tile handling - make sure to match the exact names from board.txt
-    if (line == "COLLECT OSAP") {
-      newTile = new CollectOSAP(i);
-
-    } else if (line == "DC Tims Line") {
-      newTile = new TimsLine(i);
-
-    } else if (line == "GO TO TIMS") {
-      newTile = new GoToTims(i);
-
-    } else if (line == "Goose Nesting") {
-      newTile = new GooseNesting(i);
-
-    } else if (line == "TUITION") {
-      newTile = new Tuition(i);
+    if (player->payMoney(game, tuition, owner)) {
+      game.getMetrics().recordRent(getLocation(), tuition);
+    }
+  }
+  else if (!owner) {
+    // Property is not owned, offer to buy it
+    gameOutput() << "Would you like to purchase " << getName() 
+      << " for $" << purchaseCost << "? (y/n): ";
+    
+    if (game.getDecisions().buyProperty(player, this)) {
+      if (player->canPayAmount(purchaseCost)) {
+        player->buyProperty(this);
+        return;
+      }
+      gameOutput() << "Not enough money to purchase this property." << endl;
+    }
+    // Property the lander does not take goes to the highest bidder
+    game.auctionProperty(this);
+  }
+}
 
-    } else if (line == "COOP FEE") {
-      newTile = new CoopFee(i);
 
-    } else if (line == "SLC") {
-      newTile = new SLC(i);
 
-    } else if (line == "NEEDLES HALL") {
-      newTile = new NeedlesHall(i);
+//----------------------------------
+// ACADEMIC BUILDING IMPLEMENTATIONS
+//----------------------------------
 
-    } else if (line == "PAC" || line == "CIF") {
-      // For Gym, use default values (not in CSV)
-      newTile = new Gym(line, i);
 
-    } else if (line == "MKV" || line == "UWP" || line == "V1" || line == "REV") {
-      // For Residence, use default values (not in CSV)
-      newTile = new Residence(line, i);
+AcademicBuilding::AcademicBuilding(string name, int position, int cost, int improvementCost, string block, vector<int> tuitionValues)
+  : Property(name, position, cost, TileKind::AcademicBuilding), tuitionBase(cost), improvementCost(improvementCost),
+    tuitionWithImprovements(tuitionValues), monopolyBlock(block), blockId(-1), blockSize(0) {}
 
-    } else {
-      // Assume it's an academic building
-      int cost = 0;
-      string block = "";
-      int improvementCost = 0;
-      vector<int> tuitionValues(6, 0); // Default to all zeros
-      
-      // Look up data from CSV if available
-      if (propertyData.count(line) > 0) {
-        auto& data = propertyData[line];
-        block = get<0>(data);
-        cost = get<1>(data);
-        improvementCost = get<2>(data);
-        tuitionValues = get<3>(data);
-        
-        // Use data from CSV to create AcademicBuilding
-        newTile = new AcademicBuilding(line, i, cost, improvementCost, block, tuitionValues);
-        // cout << " (Created as AcademicBuilding with CSV data)" << endl;
-      } else {
-        // If not found in CSV, use default values
-        newTile = new AcademicBuilding(line, i, 100, 50, "Unknown", tuitionValues);
-        // cout << " (Created as AcademicBuilding with default values)" << endl;
-      }
-    }
-    
-    tiles.push_back(newTile);
-    i++;
+int AcademicBuilding::getTuition() {
+  size_t improvements = getImprovements();
+  if (improvements < tuitionWithImprovements.size()) {
+    return tuitionWithImprovements[improvements];
+  } else {
+    return tuitionBase;
   }
+}
 
-  file.close();
-  
-  // Group academic buildings by monopoly block
-  for (Tile* tile : tiles) {
-    AcademicBuilding* ab = dynamic_cast<AcademicBuilding*>(tile);
-    if (ab) {
-      academicBlocks[ab->getMonopolyBlock()].push_back(ab);
-    }
+bool AcademicBuilding::addImprovement() {
+  int improvements = getImprovements();
+  if (improvements < 5) { // Max of 5 improvements
+    setImprovements(improvements + 1);
+    return true;
   }
+  return false;
 }
 
-Tile* Board::getTile(int position){
-  if (position < 0 || position >= static_cast<int>(tiles.size())){
-    cerr << "invalid position: " << position << endl;
-    cout << "returning a nullptr" << endl;
-    return nullptr;
-  }
-  else{
-    return tiles[position];
+bool AcademicBuilding::removeImprovement() {
+  int improvements = getImprovements();
+  if (improvements > 0) {
+    setImprovements(improvements - 1);
+    return true;
   }
+  return false;
 }
 
-Property* Board::getPropertyByName(const string& name){
-  for(Tile* tile : tiles){
-    if(!tile) continue; // if the tile is uninitialized
+int AcademicBuilding::getImprovements() const {
+  return holdings->improvementsAt(bit);
+}
 
-    Property* property = dynamic_cast<Property*>(tile); // making sure tile is of Property type
-    
-    if(property && property->getName() == name){
-      return property;
-    }
-  }
-  cerr << "invalid name: " << name << endl;
-  cout << "returning a nullptr" << endl;
-  return nullptr;
+void AcademicBuilding::setImprovements(int count) {
+  holdings->setImprovements(bit, count);
 }
 
-void Board::movePlayer(Player* player, int steps){
-  player->move(steps);
+int AcademicBuilding::getImprovementCost() const {
+  return improvementCost;
 }
-void Board::teleportPlayer(Player* player, int destination){
-  if(destination >= 0 && destination < static_cast<int>(tiles.size())){
-    player->teleport(destination);
-  }
-  else{
-    cerr << "invalid destination, no tile exists" << endl;
-    return;
-  }
+
+int AcademicBuilding::getTuitionAt(int level) const {
+  return level < static_cast<int>(tuitionWithImprovements.size()) ? tuitionWithImprovements[level] : tuitionBase;
 }
 
-void Board::sendToTimsLine(Player* player){
-  teleportPlayer(player, 10);  // Position 10 is the Tim's Line
-  player->enterTimsLine();
+string AcademicBuilding::getMonopolyBlock() const {
+  return monopolyBlock;
 }
 
-void Board::display() {
-  // Get players from the game
-  vector<Player*> gamePlayers;
-  Game* gameInstance = Game::getInstance();
-  if (gameInstance) {
-    gamePlayers = gameInstance->getPlayers();
-  }
-  
-  // Read the board template
-  ifstream boardFile{"board.txt"};
-  cout << endl;
+void AcademicBuilding::setBlock(int id, int size, std::uint64_t mask) {
+  blockId = id;
+  blockSize = size;
+  blockMask = mask;
+}
 
-  // Create a simple text representation if the board file isn't available
-  if (!boardFile.is_open()) {
-    cerr << "Error: Unable to open board.txt" << endl;
-    cout << "Creating a simple text representation instead." << endl;
-    
-    cout << "-----------------------------------------" << endl;
-    cout << "|   WATOPOLY BOARD - TEXT VERSION      |" << endl;
-    cout << "-----------------------------------------" << endl;
+bool AcademicBuilding::canMortgage() const {
+  return getImprovements() == 0; // Can only mortgage if there are no improvements
+}
 
-    
-    
-    // Print positions of all tiles
-    for (int i = 0; i < tiles.size(); ++i) {
-      Tile* tile = getTile(i);
-      if (tile) {
-        cout << i << ": " << tile->getName();
-        
-        // List any players at this position
-        bool playersHere = false;
-        for (auto player : gamePlayers) {
-          if (player && player->getPosition() == i) {
-            if (!playersHere) {
-              cout << " - Players: ";
-              playersHere = true;
-            }
-            cout << player->getName() << "(" << player->getPiece() << ") ";
-          }
-        }
-        cout << endl;
-      }
-    }
-    
-    cout << "-----------------------------------------" << endl;
-    return;
-  }
+void AcademicBuilding::reset() {
+  Property::reset();
+  setImprovements(0);
+}
 
-  // Read the entire board into memory
-  vector<string> boardLines;
-  string line;
-  while (getline(boardFile, line)) {
-    boardLines.push_back(line);
+bool AcademicBuilding::mortgage() {
+  if (canMortgage()) {
+    // Perform mortgage logic
+    gameOutput() << "Mortgaging " << getName() << " at " << getPurchaseCost() / 2 << " money." << endl;
+    Property::mortgage();
+    return true;
   }
-  boardFile.close();
-  int row = 4;
+  return false;
+}
 
-  for(int i = 0; i < 56; ++i){
-    // display the players 
+//----------------------------------
+// RESIDENCE IMPLEMENTATION
+//----------------------------------
 
-    if(i == row){
-      // cout << "4"; 
-      // incrementing for the next row
-      
-      line = boardLines[row];
-      // cout << line.size() << endl;
+Residence::Residence(std::string name, int position) 
+  : Property(name, position, 200, TileKind::Residence) {}
 
-      for(int p = 0; p < gamePlayers.size(); ++p){
-        int plrPos = gamePlayers[p]->getPosition();
-        char plrChar = gamePlayers[p]->getPiece();
-        // cout << plrPos << endl;
-        
-        if(plrPos < 11 && i == 54){ // first row
-          int placePlayerIndex = 88 - plrPos*8; // start of every tile in the row
-          // go over every star
-          for(int dot = 0; dot < 7; ++dot){
-            if(line[placePlayerIndex] == '*'){
-              line[placePlayerIndex] = plrChar;
-              break;
-            }
-            --placePlayerIndex;
-          }
-        } 
-        
-        else if(plrPos == 11 && i == 49){ 
-          int placePlayerIndex = 7;
-          for(int dot = 0; dot < 7; ++dot){
-            if(line[placePlayerIndex] == '*'){
-              line[placePlayerIndex] = plrChar;
-              break;
-            }
-            --placePlayerIndex;
-          }
-        }
-        // Left column (positions 11-19)
-else if(plrPos == 11 && i == 49){ 
-int placePlayerIndex = 7;
-for(int dot = 0; dot < 7; ++dot){
-if(line[placePlayerIndex] == '*'){
-line[placePlayerIndex] = plrChar;
-break;
-}
---placePlayerIndex;
-}
-}
-else if(plrPos == 12 && i == 44){ 
-int placePlayerIndex = 7;
-for(int dot = 0; dot < 7; ++dot){
-if(line[placePlayerIndex] == '*'){
-line[placePlayerIndex] = plrChar;
-break;
-}
---placePlayerIndex;
-}
-}
-else if(plrPos == 13 && i == 39){ 
-int placePlayerIndex = 7;
-for(int dot = 0; dot < 7; ++dot){
-if(line[placePlayerIndex] == '*'){
-line[placePlayerIndex] = plrChar;
-break;
-}
---placePlayerIndex;
-}
-}
-else if(plrPos == 14 && i == 34){ 
-int placePlayerIndex = 7;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  --placePlayerIndex;
-}
-}
-else if(plrPos == 15 && i == 29){ 
-int placePlayerIndex = 7;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  --placePlayerIndex;
-}
-}
-else if(plrPos == 16 && i == 24){ 
-int placePlayerIndex = 7;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  --placePlayerIndex;
-}
-}
-else if(plrPos == 17 && i == 19){ 
-int placePlayerIndex = 7;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  --placePlayerIndex;
-}
-}
-else if(plrPos == 18 && i == 14){ 
-int placePlayerIndex = 7;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  --placePlayerIndex;
-}
-}
-else if(plrPos == 19 && i == 9){ 
-int placePlayerIndex = 7;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  --placePlayerIndex;
-}
-}
-// Top row (positions 20-30)
-else if(plrPos >= 20 && plrPos <= 30 && i == 4){
-int placePlayerIndex = 0 + (plrPos - 20)*8;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  ++placePlayerIndex;
-}
-}
-else if(plrPos == 31 && i == 9){
-int placePlayerIndex = 87;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  ++placePlayerIndex;
-}
-}
-else if(plrPos == 32 && i == 14){
-int placePlayerIndex = 87;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  ++placePlayerIndex;
-}
-}
-else if(plrPos == 33 && i == 19){
-int placePlayerIndex = 87;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  ++placePlayerIndex;
-}
-}
-else if(plrPos == 34 && i == 24){
-int placePlayerIndex = 87;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  ++placePlayerIndex;
-}
-}
-else if(plrPos == 35 && i == 29){
-int placePlayerIndex = 87;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
-  }
-  ++placePlayerIndex;
-}
-}
-else if(plrPos == 36 && i == 34){
-int placePlayerIndex = 87;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
+int Residence::getTuition() {
+  if (!getOwner()) {
+    return 0; // No rent if no owner
   }
-  ++placePlayerIndex;
-}
-}
-else if(plrPos == 37 && i == 39){
-int placePlayerIndex = 87;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
+
+  switch (getOwner()->getResidencesOwned()) {
+    case 1: return 25;
+    case 2: return 50;
+    case 3: return 100;
+    case 4: return 200;
+    default: return 25;
   }
-  ++placePlayerIndex;
 }
+
+//----------------------------------
+// GYM IMPLEMENTATION
+//----------------------------------
+Gym::Gym(std::string name, int position) 
+  : Property(name, position, 150, TileKind::Gym), diceRoll(0) {}
+
+void Gym::setDiceRoll(int total) {
+  diceRoll = total;
 }
-else if(plrPos == 38 && i == 44){
-int placePlayerIndex = 87;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
+
+int Gym::getTuition() {
+  if (!getOwner() || diceRoll == 0) {
+    return 0; // No rent if unowned or dice not set
   }
-  ++placePlayerIndex;
-}
-}
-else if(plrPos == 39 && i == 49){
-int placePlayerIndex = 87;
-for(int dot = 0; dot < 7; ++dot){
-  if(line[placePlayerIndex] == '*'){
-    line[placePlayerIndex] = plrChar;
-    break;
+
+  // Determine the appropriate multiplier
+  int multiplier;
+  if (getOwner()->getGymsOwned() == 2) {
+    multiplier = multiplierOwnedTwo;
+  } else {
+    multiplier = multiplierOwnedOne;
   }
-  ++placePlayerIndex;
-}
-}
 
-} 
-++i;
-cout << line << endl;
-row = row + 5;
+  return diceRoll * multiplier;
 }
-    
 
-cout << boardLines[i] << endl;
-}
+//----------------------------------
+// COLLECT OSAP IMPLEMENTATION
+//----------------------------------
+CollectOSAP::CollectOSAP(int position) 
+  : Tile("Collect OSAP", position, TileKind::CollectOSAP) {}
 
+void CollectOSAP::landedOn(Game&, Player* player) {
+  // Award $200 for landing on or passing Collect OSAP
+  gameOutput() << "You landed on Collect OSAP. Receive $200" << endl;
+  player->receiveMoney(200);
 }
 
 //----------------------------------
-// GAME IMPLEMENTATIONS
+// COOP FEE IMPLEMENTATION
 //----------------------------------
+CoopFee::CoopFee(int position) 
+  : Tile("Coop Fee", position, TileKind::CoopFee) {}
 
-// Add static member for singleton pattern
-Game::Game(bool testMode) : 
-  currentPlayerIndex(0),
-  maxTimsCups(4),
-  isTestingMode(testMode),
-  dice(testMode),
-  currentTimsCupsInGame(0){
-  commandInterpreter = new CommandInterpreter(this, isTestingMode);
-  // Other initialization
-  if (instance == nullptr) {
-    instance = this;
-  }
-}
-
-Game::~Game() {
-delete commandInterpreter;
-}
+void CoopFee::landedOn(Game& game, Player* player) {
+  const int feeAmount = 150;  // Fixed $150 fee as per requirements
 
-std::vector<Player*> Game::getPlayers() {
-return players;
+  gameOutput() << "You landed on Coop Fee. You must pay $" << feeAmount << endl;
+  
+  player->payMoneyToBank(game, feeAmount);
+    // If player can't pay, handle bankruptcy 
 }
 
-Game* Game::instance = nullptr;
-
-Game* Game::getInstance() {
-if (instance == nullptr) {
-    instance = new Game();
-}
-return instance;
-}
+//----------------------------------
+// GO TO TIMS IMPLEMENTATION
+//----------------------------------
+GoToTims::GoToTims(int position) 
+  : Tile("Go To Tims", position, TileKind::GoToTims) {}
 
-void Game::initialize(int numPlayers) {
-// Initialize players, board, etc.
-if (numPlayers < 2 || numPlayers > 6) {
-    std::cout << "Invalid number of players. Please enter a number between 2 and 6." << std::endl;
-    return;
+void GoToTims::landedOn(Game&, Player* player) {
+  gameOutput() << "You landed on Go To Tims. Moving to DC Tims Line!" << endl;
+  
+  // Directly send player to DC Tims Line (position 10)
+  player->teleport(10);
+  player->enterTimsLine();
+  
+  gameOutput() << player->getName() << " is now in the DC Tims Line." << endl;
 }
 
-std::vector<char> availablePieces = {'G','B','D','P','S','$','L','T'};
-std::vector<std::string> pieceNames = {"Goose", "Beer Bottle", "Donut", "Pink Tie", "Stetson", "Money", "Laptop", "T-Rex"};
+//----------------------------------
+// TIMS LINE IMPLEMENTATION
+//----------------------------------
+TimsLine::TimsLine(int position) 
+  : Tile("DC Tims Line", position, TileKind::TimsLine) {}
 
-// Clear any existing players
-for (auto player : players) {
-    delete player;
+void TimsLine::landedOn(Game&, Player* player) {
+  if (!player) return;
+  
+  gameOutput() << player->getName() << " has landed on DC Tims Line." << endl;
+  gameOutput() << "This is just visiting - no effect." << endl;
+  // No effect if just visiting
 }
-players.clear();
 
-for (int i = 0; i < numPlayers; ++i) {
-    std::string playerName;
-    char playerPiece;
+//----------------------------------
+// NEEDLES HALL IMPLEMENTATION
+//----------------------------------
+// Card decks are immutable, so every tile of a kind shares one table built on first use
+static const AliasTable& needlesHallDeck() {
+  static const AliasTable deck({
+    {-200, 1},  // Lose $200, 1/18
+    {-100, 2},  // Lose $100, 1/9
+    {-50,  3},  // Lose $50, 1/6
+    {25,   6},  // Gain $25, 1/3
+    {50,   3},  // Gain $50, 1/6
+    {100,  2},  // Gain $100, 1/9
+    {200,  1}   // Gain $200, 1/18
+  });
+  return deck;
+}
 
-    std::cout << "Enter name for Player " << i + 1 << ": ";
-    std::cin >> playerName;
+NeedlesHall::NeedlesHall(int position)
+  : Tile("Needles Hall", position, TileKind::NeedlesHall), money_changes{needlesHallDeck()} {}
 
-    std::cout << "Available pieces: ";
-    size_t j;
-    for (j = 0; j < availablePieces.size(); ++j) {
-        std::cout << availablePieces[j] << " (" << pieceNames[j] << ") ";
-    }
-    std::cout << std::endl;
+void NeedlesHall::landedOn(Game& game, Player* player) {
+  gameOutput() << player->getName() <<" landed on Needles Hall!" << endl;
 
-    bool validPiece = false;
-    while (!validPiece) {
-        std::cout << "Enter piece for Player " << i + 1 << ": ";
-        std::cin >> playerPiece;
+  Rng& rng = game.getRng();
+  int amount = money_changes.draw(rng);
 
-        auto it = std::find(availablePieces.begin(), availablePieces.end(), playerPiece);
-        if (it != availablePieces.end()) {
-            availablePieces.erase(it);
-            pieceNames.erase(pieceNames.begin() + (it - availablePieces.begin()));
-            validPiece = true;
-        } else {
-            std::cout << "Invalid piece. Please choose from the available pieces." << std::endl;
-        }
-    }
+  if (amount > 0) {
+    gameOutput() << "You received $" << amount << "!" << endl;
+    player->receiveMoney(amount);
+  } else {
+    gameOutput() << "You must pay $" << -amount << "." << endl;
+    player->receiveMoney(amount);
+    // if (!success) {
+    //     gameOutput() << "You cannot pay and must declare bankruptcy or raise funds." << endl;
+    // }
+  }
 
-    Player* player = new Player(playerName, playerPiece);
-    players.push_back(player);
+  // 1% chance to get a Roll Up the Rim cup
+  if (rng.chance(1, 100)) {
+    player->addTimsCup(game);
+  }
 }
 
-currentPlayerIndex = 0;
-maxTimsCups = 4;
-currentTimsCupsInGame = 0;
+//----------------------------------
+// SLC 
+//----------------------------------
+// Shared with the landing analysis, which needs the weights themselves
+static const vector<pair<int, int>>& slcMovements() {
+  static const vector<pair<int, int>> movements{
+    {-3, 3},  // 1/8
+    {-2, 4},  // 1/6
+    {-1, 4},  // 1/6
+    {1, 3},   // 1/8
+    {2, 4},   // 1/6
+    {3, 4},   // 1/6
+    {10, 1},  // DC Tims Line, 1/24
+    {0, 1}    // Collect OSAP, 1/24
+  };
+  return movements;
 }
 
-// Change to static method per declaration
-void Game::loadGame(std::string filename) {
-std::ifstream file(filename);
-if (!file.is_open()) {
-    std::cerr << "Error opening file: " << filename << std::endl;
-    return;
+static const AliasTable& slcDeck() {
+  static const AliasTable deck(slcMovements());
+  return deck;
 }
 
-// Clear existing game state
-for (auto player : players) {
-    delete player;
-}
-players.clear();
-currentTimsCupsInGame = 0;
+SLC::SLC(int position) : Tile("SLC", position, TileKind::SLC), movements{slcDeck()} {}
 
-int numPlayers;
-file >> numPlayers;
-file.ignore(); // Consume the newline character
+void SLC::landedOn(Game& game, Player* player) {
+  gameOutput() << "You landed on SLC (Student Life Centre)!" << endl;
+  
+  Rng& rng = game.getRng();
+  int move = movements.draw(rng);
+  
+  if (move == 10) {
+    gameOutput() << "The card sends you to DC Tims Line!" << endl;
+    // Send to Tims Line
+    game.getBoard().sendToTimsLine(player);
+  } else if (move == 0) {
+    gameOutput() << "The card sends you to Collect OSAP!" << endl;
+    // Go to Collect OSAP
+    player->teleport(0);
+    
+    // Since we're moving to Collect OSAP, we should also give $200
+    player->receiveMoney(200);
+    gameOutput() << "You collect $200 for passing OSAP." << endl;
+  } else {
+    if (move > 0) {
+      gameOutput() << "The card moves you forward " << move << " spaces." << endl;
+    } else {
+      gameOutput() << "The card moves you backward " << -move << " spaces." << endl;
+    }
+    
+    // Move forward/backward
+    player->move(move);
+  }
 
-for (int i = 0; i < numPlayers; ++i) {
-    std::string line;
-    std::getline(file, line);
-    std::stringstream ss(line);
+  // 1% chance to get a Roll Up the Rim cup
+  if (rng.chance(1, 100)) {
+    player->addTimsCup(game);
+  }
+}
 
-    std::string playerName;
-    char playerPiece;
+//----------------------------------
+// TUITION
+//----------------------------------
+Tuition::Tuition(int position) : Tile("Tuition", position, TileKind::Tuition) {}
+
+void Tuition::landedOn(Game& game, Player* player) {
+  gameOutput() << "You landed on Tuition!" << endl;
+  
+  // Calculate 10% of total worth
+  const int totalWorth = player->getNetWorth();
+  const int tenPercent = static_cast<int>(totalWorth * 0.1);
+  const int flatFee = 300;
+
+  // Display options to the player
+  gameOutput() << "Tuition options:" << std::endl;
+  gameOutput() << "1. Pay $" << flatFee << " flat fee" << std::endl;
+  gameOutput() << "2. Pay $" << tenPercent << " (one 10th of your total worth)" << std::endl;
+  gameOutput() << "Enter choice (1 or 2): ";
+  
+  if (game.getDecisions().payTuitionFlatFee(player, flatFee, tenPercent)) {
+    // Player chose to pay flat fee
+    gameOutput() << "You paid the flat fee of $" << flatFee << "." << endl;
+    bool success = player->payMoneyToBank(game, flatFee);
+    if (!success) {
+      gameOutput() << "You cannot pay tuition and must declare bankruptcy or raise funds." << endl;
+    }
+  } else {
+    // Player chose to pay percentage
+    gameOutput() << "You paid one 10th of your worth: $" << tenPercent << "." << endl;
+    bool success = player->payMoneyToBank(game, tenPercent);
+    if (!success) {
+      gameOutput() << "You cannot pay tuition and must declare bankruptcy or raise funds." << endl;
+    }
+  }
+}
+
+//----------------------------------
+// GOOSE NESTING
+//----------------------------------
+GooseNesting::GooseNesting(int position) 
+  : Tile("Goose Nesting", position, TileKind::GooseNesting) {}
+
+void GooseNesting::landedOn(Game& game, Player*) {
+  gameOutput() << "You landed on Goose Nesting!" << endl;
+  
+  Rng& rng = game.getRng();
+  
+  // Display random goose encounter message
+  std::string message = gooseMessages[rng.uniform(gooseMessages.size())];
+  gameOutput() << message << std::endl;
+  
+  // No game effect occurs (no money lost, no movement)
+  gameOutput() << "Fortunately, you escaped without any monetary damage." << endl;
+}
+
+//----------------------------------
+// PLAYER IMPLEMENTATIONS
+//----------------------------------
+Player::Player(std::string name, char piece, const Board& board) : 
+  name{name}, 
+  piece{piece}, 
+  money{1500}, 
+  position{0}, 
+  inTimsLine{false}, 
+  turnsInTimsLine{0}, 
+  timsCups{0}, 
+  board{board},
+  owned{0} // no properties yet
+{
+}
+
+
+void Player::move(int steps){
+
+if(steps < 0){
+  int tmp = position + steps;
+  if (tmp < 0){
+    tmp = 40 + tmp ;
+  }
+  position = tmp;
+  return;
+}
+
+int tmp = (position + steps) % 40;
+if(tmp < position){
+  receiveMoney(200);
+  position = tmp;
+}
+position = tmp;
+return;
+}
+
+void Player::teleport(int destination){
+
+position = destination;
+return;
+}
+
+bool Player::payMoney(Game& game, int amount, Player* recipient) {
+  // If we can't afford it, allow the player to sell properties
+  if(!canPayAmount(amount)) {
+    gameOutput() << "You DO NOT have the cash to continue, you must sell some property to continue." << endl;
+    if (raiseByMortgage(game, amount)) {
+      return payMoney(game, amount, recipient);
+    }
+    // Display available properties
+    if(owned == 0) {
+      gameOutput() << "You don't have any properties to sell." << endl;
+      declaredBankruptcy(recipient);
+      
+      // Notify the game that this player has gone bankrupt
+      gameOutput() << "Player " << name << " has left the game due to bankruptcy." << endl;
+      game.removeBankruptPlayer(this);
+      
+      return false;
+    }
+    
+    auto properties = getProperties();
+    gameOutput() << "Available properties:" << endl;
+    for(size_t i = 0; i < properties.size(); i++) {
+      gameOutput() << i + 1 << ": " << properties[i]->getName();
+      if(properties[i]->isMortgaged()) {
+        gameOutput() << " (mortgaged)";
+      }
+      gameOutput() << " - Worth $" << properties[i]->getPurchaseCost() / 2 << endl;
+    }
+    
+    // Let player choose a property
+    gameOutput() << "Enter property number (0 to cancel): ";
+    int choice = game.getDecisions().chooseAssetToSell(this, amount);
+    
+    if(choice < 0 || choice >= static_cast<int>(properties.size())) {
+      gameOutput() << "Sale canceled." << endl;
+      return false;
+    }
+    
+    // Sell the chosen property
+    Property* propertyToSell = properties[choice];
+    int proceeds = sellProperty(propertyToSell);
+    gameOutput() << "Sold " << propertyToSell->getName() << " to the bank for $" 
+       << proceeds << endl;
+    
+    // Recursively try to pay again
+    return payMoney(game, amount, recipient);
+  }
+
+  // Double-check that we have enough money
+  if(money - amount < 0) {
+    int netWorth = getNetWorth();
+    return false;
+  }
+
+  // Process the payment
+  money = money - amount;
+  if(recipient) {
+    recipient->receiveMoney(amount);
+  }
+  return true;
+}
+
+bool Player::payMoneyToBank(Game& game, int amount) {
+  // If we can't afford it, allow the player to sell properties
+  if(!canPayAmount(amount)) {
+    gameOutput() << "You DO NOT have the cash to continue, you must sell some property to continue." << endl;
+    if (raiseByMortgage(game, amount)) {
+      return payMoneyToBank(game, amount);
+    }
+    // Display available properties
+    if(owned == 0) {
+      gameOutput() << "You don't have any properties to sell." << endl;
+      declaredBankruptcy(nullptr); // nullptr because we're paying the bank
+      
+      // Notify the game that this player has gone bankrupt
+      gameOutput() << "Player " << name << " has left the game due to bankruptcy." << endl;
+      game.removeBankruptPlayer(this);
+      
+      return false;
+    }
+    
+    auto properties = getProperties();
+    gameOutput() << "Available properties:" << endl;
+    for(size_t i = 0; i < properties.size(); i++) {
+      gameOutput() << i + 1 << ": " << properties[i]->getName();
+      if(properties[i]->isMortgaged()) {
+        gameOutput() << " (mortgaged)";
+      }
+      gameOutput() << " - Worth $" << properties[i]->getPurchaseCost() / 2 << endl;
+    }
+    
+    // Let player choose a property
+    gameOutput() << "Enter property number (0 to cancel): ";
+    int choice = game.getDecisions().chooseAssetToSell(this, amount);
+    
+    if(choice < 0 || choice >= static_cast<int>(properties.size())) {
+      gameOutput() << "Sale canceled." << endl;
+      return false;
+    }
+    
+    // Sell the chosen property
+    Property* propertyToSell = properties[choice];
+    int proceeds = sellProperty(propertyToSell);
+    gameOutput() << "Sold " << propertyToSell->getName() << " to the bank for $" 
+       << proceeds << endl;
+    
+    // Recursively try to pay again
+    return payMoneyToBank(game, amount);
+  }
+
+  // Double-check that we have enough money
+  if(money - amount < 0) {
+    int netWorth = getNetWorth();
+    return false;
+  }
+
+  // Process the payment
+  money = money - amount;
+  game.getBank().collectMoney(amount);
+  return true;
+}
+
+// Adds money to the player's balance
+void Player::receiveMoney(int amount) {
+  money += amount;
+}
+
+// Sells a property back to the bank: half price unless mortgaged, plus half the
+// cost of its improvements. The tile goes back unmortgaged and unimproved.
+int Player::sellProperty(Property* property) {
+  if (!(owned & property->getMask())) {
+    return 0;
+  }
+  int proceeds = property->isMortgaged() ? 0 : property->getPurchaseCost() / 2;
+  if (auto academic = asAcademicBuilding(property)) {
+    proceeds += academic->getImprovements() * academic->getImprovementCost() / 2;
+  }
+  receiveMoney(proceeds);
+  releaseProperty(property);
+  property->reset();
+  return proceeds;
+}
+
+// Lets the player's decisions pick a holding to mortgage before anything is sold.
+// Improved buildings have to lose their improvements first, so they are refused.
+bool Player::raiseByMortgage(Game& game, int amountOwed) {
+  int choice = game.getDecisions().chooseAssetToMortgage(this, amountOwed);
+  if (choice < 0 || choice >= std::popcount(owned)) {
+    return false;
+  }
+  Property* property = getProperties()[choice];
+  AcademicBuilding* academic = asAcademicBuilding(property);
+  if ((academic && academic->getImprovements() > 0) || !mortgageProperty(property)) {
+    return false;
+  }
+  gameOutput() << name << " mortgaged " << property->getName() << " for $" << property->getPurchaseCost() / 2 << endl;
+  return true;
+}
+
+// Mortgages a property for half its purchase price
+bool Player::mortgageProperty(Property* property) {
+  if (!property->isMortgaged()) {
+    receiveMoney(property->getPurchaseCost() / 2);
+    property->mortgage();
+    return true;
+  }
+  return false;
+}
+
+// Unmortgages a property by paying back half its purchase price
+bool Player::unmortgageProperty(Game& game, Property* property) {
+if (property->isMortgaged()) {
+    payMoneyToBank(game, property->getPurchaseCost() / 2);
+    property->unmortgage();
+    return true;
+}
+return false;
+}
+
+// Checks if the player has enough money to cover an amount
+bool Player::canPayAmount(int amount) {
+  return money >= amount;
+}
+
+// Calculates total net worth
+int Player::getNetWorth() {
+  return money + board.getHoldingValue(owned);
+}
+
+// Declares bankruptcy
+void Player::declaredBankruptcy(Player* creditor) {
+  if (creditor) {
+    // The creditor takes every holding at once; only the owner pointers need a walk
+    creditor->owned |= owned;
+    for (std::uint64_t rest = owned; rest; rest &= rest - 1) {
+      board.getPropertyByBit(std::countr_zero(rest))->setOwner(creditor);
+    }
+  } else {
+    // Holdings go back to the bank unmortgaged and unimproved
+    for (std::uint64_t rest = owned; rest; rest &= rest - 1) {
+      board.getPropertyByBit(std::countr_zero(rest))->reset();
+    }
+  }
+  owned = 0;
+  money = 0;
+  gameOutput() << name << " has declared bankruptcy!" << endl;
+}
+
+// Sends player to the Tim's Line
+void Player::enterTimsLine() {
+  inTimsLine = true;
+  turnsInTimsLine = 0;
+}
+
+// Releases player from Tim's Line
+void Player::leaveTimsLine() {
+  inTimsLine = false;
+  turnsInTimsLine = 0;
+}
+
+// Adds a Tim's Cup
+void Player::addTimsCup(Game& game) {
+  if(game.canGiveMoreCups()) {
+    timsCups++;
+    game.currentTimsCupsInGame++;
+    gameOutput() << "Congratulations! You received a Roll Up the Rim cup!" << endl;
+  }
+}
+
+// Uses a Tim's Cup to escape from Tim's Line
+bool Player::useTimsCup() {
+  if (timsCups > 0) {
+    timsCups--;
+    leaveTimsLine();
+    return true;
+  }
+  return false;
+}
+
+// Helper method needed by CommandInterpreter
+void Player::incrementTurnsInTimsLine() {
+  turnsInTimsLine++;
+}
+
+bool Player::ownsMonopoly(const AcademicBuilding* building) const {
+  // Player has monopoly if they hold every bit of the block's mask
+  std::uint64_t block = building->getBlockMask();
+  return block != 0 && (owned & block) == block;
+}
+
+std::uint64_t Player::getMonopolies() const {
+  return board.getMonopolies(owned);
+}
+
+int Player::getResidencesOwned() const {
+  return std::popcount(owned & board.getResidenceMask());
+}
+
+int Player::getGymsOwned() const {
+  return std::popcount(owned & board.getGymMask());
+}
+
+int Player::getOwnedInBlock(int blockId) const {
+  return std::popcount(owned & board.getBlockMask(blockId));
+}
+
+FixedVector<Property*, maxTiles> Player::getProperties() const {
+  FixedVector<Property*, maxTiles> properties;
+  for (std::uint64_t rest = owned; rest; rest &= rest - 1) {
+    properties.push_back(board.getPropertyByBit(std::countr_zero(rest)));
+  }
+  return properties;
+}
+
+bool Player::buyProperty(Property* property) {
+  // Validate the property
+  if (!property) {
+    errorOutput() << "Invalid property." << std::endl;
+    return false;
+  }
+
+  // Check if property is already owned
+  if (property->getOwner()) {
+    gameOutput() << "Property already owned by " << property->getOwner()->getName() << std::endl;
+    return false;
+  }
+
+  // Check if player has enough money
+  int cost = property->getPurchaseCost();
+  if (money < cost) {
+    gameOutput() << "Not enough money to buy property." << std::endl;
+    return false;
+  }
+
+  // Process purchase
+  money -= cost;
+  acquireProperty(property);
+  
+  gameOutput() << name << " purchased " << property->getName() << " for $" << cost << std::endl;
+  return true;
+}
+
+bool Player::buyImprovement(AcademicBuilding* property) {
+  // Validate the property
+  if (!property) {
+    errorOutput() << "Invalid property." << std::endl;
+    return false;
+  }
+
+  // Check if player owns the property
+  if (property->getOwner() != this) {
+    gameOutput() << "You don't own this property." << std::endl;
+    return false;
+  }
+
+  // Check if player has monopoly on this block
+  if (!ownsMonopoly(property)) {
+    gameOutput() << "You need to own all properties in the " << property->getMonopolyBlock() << " block to buy improvements." << std::endl;
+    return false;
+  }
+
+  // Check if property already has maximum improvements
+  if (property->getImprovements() >= 5) {
+    gameOutput() << "This property already has maximum improvements." << std::endl;
+    return false;
+  }
+
+  // Check if player has enough money
+  int cost = property->getImprovementCost();
+  if (money < cost) {
+    gameOutput() << "Not enough money to buy improvement." << std::endl;
+    return false;
+  }
+
+  // Process improvement purchase
+  if (!property->addImprovement()) {
+    gameOutput() << "Failed to add improvement." << std::endl;
+    return false;
+  }
+
+  money -= cost;
+  gameOutput() << name << " bought an improvement on " << property->getName() << " for $" << cost << std::endl;
+  return true;
+}
+
+void Player::tradePropertyInsteadOfPaying(Property* property, Player* recipient) {
+  // Implementation pending
+}
+
+std::string Player::getAssets() {
+  std::stringstream ss;
+  ss << "Cash: $" << money << std::endl;
+  ss << "Properties:" << std::endl;
+  for (const auto& property : getProperties()) {
+    ss << "- " << property->getName();
+    if (property->isMortgaged()) {
+      ss << " (mortgaged)";
+    }
+    ss << std::endl;
+  }
+  ss << "Tim's Cups: " << timsCups << std::endl;
+  return ss.str();
+}
+
+// All ownership changes go through acquireProperty/releaseProperty so the
+// holding bits and the owner pointers always agree
+void Player::acquireProperty(Property* property) {
+  property->setOwner(this);
+  owned |= property->getMask();
+}
+
+void Player::releaseProperty(Property* property) {
+  if (!(owned & property->getMask())) return;
+  owned &= ~property->getMask();
+  property->setOwner(nullptr);
+}
+
+void Player::restoreState(char piece, int money, int position, bool inTimsLine, int turnsInTimsLine, int timsCups) {
+  this->piece = piece;
+  this->money = money;
+  this->position = position;
+  this->inTimsLine = inTimsLine;
+  this->turnsInTimsLine = turnsInTimsLine;
+  this->timsCups = timsCups;
+  owned = 0;
+}
+
+bool Player::sellImprovement(AcademicBuilding* property) {
+  if (!property) {
+    errorOutput() << "Invalid property." << std::endl;
+    return false;
+  }
+  
+  if (property->getOwner() != this) {
+    gameOutput() << "You don't own this property." << std::endl;
+    return false;
+  }
+  
+  if (property->getImprovements() <= 0) {
+    gameOutput() << "This property has no improvements to sell." << std::endl;
+    return false;
+  }
+  
+  // Process selling
+  if (!property->removeImprovement()) {
+    gameOutput() << "Failed to remove improvement." << std::endl;
+    return false;
+  }
+  
+  // Calculate half the price
+  int refund = property->getImprovementCost() / 2;
+  receiveMoney(refund);
+  
+  gameOutput() << name << " sold an improvement on " << property->getName() 
+        << " for $" << refund << std::endl;
+  return true;
+}
+
+//----------------------------------
+// BOARD IMPLEMENTATIONS
+//----------------------------------
+
+Board::Board() : arena{ownArena} {
+initializeBoard(); 
+}
+
+Board::Board(Arena& arena) : arena{arena} {
+initializeBoard();
+}
+
+void Board::initializeBoard() {
+  // First, read property data from CSV file
+  map<string, tuple<string, int, int, vector<int>>> propertyData;
+  
+  ifstream csv{"watopoly_data.csv"};
+  if (csv.is_open()) {
+    string line;
+    // Skip header row
+    getline(csv, line);
+    
+    while (getline(csv, line)) {
+      stringstream ss(line);
+      string item;
+      vector<string> row;
+      
+      while (getline(ss, item, ',')) {
+        row.push_back(item);
+      }
+      
+      if (row.size() >= 10) { // Ensure we have enough columns
+        string name = row[0];
+        string block = row[1];
+        int purchaseCost = stoi(row[2]);
+        int improvementCost = stoi(row[3]);
+        
+        // Parse tuition values (columns 4-9 are the tuition values for 0-5 improvements)
+        vector<int> tuitionValues;
+        for (size_t i = 4; i < 10; ++i) {
+          tuitionValues.push_back(stoi(row[i]));
+        }
+        
+        propertyData[name] = make_tuple(block, purchaseCost, improvementCost, tuitionValues);
+      }
+    }
+    csv.close();
+  } else {
+    errorOutput() << "Warning: Could not open watopoly_data.csv, using default values" << endl;
+  }
+
+  // Now read the board layout
+  ifstream file{"boardTileOrder.txt"};
+  string line;
+  if (!file.is_open()) {
+    errorOutput() << "Error: Unable to open boardTileOrder.txt" << endl;
+    return;
+  }
+
+  int i = 0;
+  while (getline(file, line)) {
+    Tile* newTile = nullptr;
+    
+    // Trim any whitespace from the line
+    line.erase(0, line.find_first_not_of(" \t\r\n"));
+    line.erase(line.find_last_not_of(" \t\r\n") + 1);
+    
+    // Debug: Print the tile being created -- not needed anymore
+    
+    // Special tile handling - make sure to match the exact names from board.txt
+    if (line == "COLLECT OSAP") {
+      newTile = arena.make<CollectOSAP>(i);
+
+    } else if (line == "DC Tims Line") {
+      newTile = arena.make<TimsLine>(i);
+
+    } else if (line == "GO TO TIMS") {
+      newTile = arena.make<GoToTims>(i);
+
+    } else if (line == "Goose Nesting") {
+      newTile = arena.make<GooseNesting>(i);
+
+    } else if (line == "TUITION") {
+      newTile = arena.make<Tuition>(i);
+
+    } else if (line == "COOP FEE") {
+      newTile = arena.make<CoopFee>(i);
+
+    } else if (line == "SLC") {
+      newTile = arena.make<SLC>(i);
+
+    } else if (line == "NEEDLES HALL") {
+      newTile = arena.make<NeedlesHall>(i);
+
+    } else if (line == "PAC" || line == "CIF") {
+      // For Gym, use default values (not in CSV)
+      newTile = arena.make<Gym>(line, i);
+
+    } else if (line == "MKV" || line == "UWP" || line == "V1" || line == "REV") {
+      // For Residence, use default values (not in CSV)
+      newTile = arena.make<Residence>(line, i);
+
+    } else {
+      // Assume it's an academic building
+      int cost = 0;
+      string block = "";
+      int improvementCost = 0;
+      vector<int> tuitionValues(6, 0); // Default to all zeros
+      
+      // Look up data from CSV if available
+      if (propertyData.count(line) > 0) {
+        auto& data = propertyData[line];
+        block = get<0>(data);
+        cost = get<1>(data);
+        improvementCost = get<2>(data);
+        tuitionValues = get<3>(data);
+        
+        // Use data from CSV to create AcademicBuilding
+        newTile = arena.make<AcademicBuilding>(line, i, cost, improvementCost, block, tuitionValues);
+        // gameOutput() << " (Created as AcademicBuilding with CSV data)" << endl;
+      } else {
+        // If not found in CSV, use default values
+        newTile = arena.make<AcademicBuilding>(line, i, 100, 50, "Unknown", tuitionValues);
+        // gameOutput() << " (Created as AcademicBuilding with default values)" << endl;
+      }
+    }
+    
+    tiles.push_back(newTile);
+    i++;
+  }
+
+  file.close();
+  
+  // Group academic buildings by monopoly block
+  for (Tile* tile : tiles) {
+    AcademicBuilding* ab = asAcademicBuilding(tile);
+    if (ab) {
+      academicBlocks[ab->getMonopolyBlock()].push_back(ab);
+    }
+  }
+
+  // Index properties by name for the command and load paths
+  propertyIndex.clear();
+  for (int pos = 0; pos < static_cast<int>(tiles.size()); ++pos) {
+    if (tiles[pos] && tiles[pos]->isProperty()) {
+      propertyIndex[tiles[pos]->getName()] = pos;
+    }
+  }
+
+  // Number the purchasable tiles in board order; each owns one holding bit
+  for (Tile* tile : tiles) {
+    if (Property* property = asProperty(tile)) {
+      int bit = static_cast<int>(properties.size());
+      property->placeOn(&holdings, bit);
+      properties.push_back(property);
+      purchaseCosts[bit] = property->getPurchaseCost();
+      if (AcademicBuilding* academic = asAcademicBuilding(property)) {
+        improvementCosts[bit] = academic->getImprovementCost();
+      }
+      if (property->getKind() == TileKind::Residence) residenceMask |= property->getMask();
+      if (property->getKind() == TileKind::Gym) gymMask |= property->getMask();
+    }
+  }
+
+  // Intern each block as a small integer ID so monopoly checks never compare names
+  int blockId = 0;
+  for (auto& [block, members] : academicBlocks) {
+    for (AcademicBuilding* ab : members) {
+      blockMasks[blockId] |= ab->getMask();
+    }
+    for (AcademicBuilding* ab : members) {
+      ab->setBlock(blockId, static_cast<int>(members.size()), blockMasks[blockId]);
+    }
+    blockId++;
+  }
+  blockCount = blockId;
+}
+
+int Board::getHoldingValue(std::uint64_t mask) const {
+  int total = 0;
+  for (; mask; mask &= mask - 1) {
+    int bit = std::countr_zero(mask);
+    total += purchaseCosts[bit] + holdings.improvementsAt(bit) * improvementCosts[bit];
+  }
+  return total;
+}
+
+std::uint64_t Board::getMonopolies(std::uint64_t mask) const {
+  std::uint64_t complete = 0;
+  for (int block = 0; block < blockCount; ++block) {
+    std::uint64_t members = blockMasks[block];
+    complete |= members & (0 - static_cast<std::uint64_t>((mask & members) == members));
+  }
+  return complete;
+}
+
+Tile* Board::getTile(int position) const {
+  if (position < 0 || position >= static_cast<int>(tiles.size())){
+    errorOutput() << "invalid position: " << position << endl;
+    gameOutput() << "returning a nullptr" << endl;
+    return nullptr;
+  }
+  else{
+    return tiles[position];
+  }
+}
+
+Property* Board::getPropertyByName(const string& name){
+  Property* property = findProperty(name);
+  if (!property) {
+    errorOutput() << "invalid name: " << name << endl;
+  }
+  return property;
+}
+
+Property* Board::findProperty(const string& name) const {
+  auto it = propertyIndex.find(name);
+  return it == propertyIndex.end() ? nullptr : static_cast<Property*>(tiles[it->second]);
+}
+
+// Resolves a landing by switching on the tile's kind; the qualified calls skip the vtable
+void Board::landOn(Game& game, Tile* tile, Player* player){
+  switch(tile->getKind()){
+    case TileKind::AcademicBuilding:
+    case TileKind::Residence:
+    case TileKind::Gym:
+      static_cast<Property*>(tile)->Property::landedOn(game, player);
+      break;
+    case TileKind::CollectOSAP:
+      static_cast<CollectOSAP*>(tile)->CollectOSAP::landedOn(game, player);
+      break;
+    case TileKind::CoopFee:
+      static_cast<CoopFee*>(tile)->CoopFee::landedOn(game, player);
+      break;
+    case TileKind::GoToTims:
+      static_cast<GoToTims*>(tile)->GoToTims::landedOn(game, player);
+      break;
+    case TileKind::TimsLine:
+      static_cast<TimsLine*>(tile)->TimsLine::landedOn(game, player);
+      break;
+    case TileKind::NeedlesHall:
+      static_cast<NeedlesHall*>(tile)->NeedlesHall::landedOn(game, player);
+      break;
+    case TileKind::SLC:
+      static_cast<SLC*>(tile)->SLC::landedOn(game, player);
+      break;
+    case TileKind::Tuition:
+      static_cast<Tuition*>(tile)->Tuition::landedOn(game, player);
+      break;
+    case TileKind::GooseNesting:
+      static_cast<GooseNesting*>(tile)->GooseNesting::landedOn(game, player);
+      break;
+  }
+}
+
+// Hands every property back to the bank so the board can host a fresh game
+void Board::reset(){
+  for(Tile* tile : tiles){
+    Property* property = asProperty(tile);
+    if(property){
+      property->reset();
+    }
+  }
+}
+
+void Board::movePlayer(Player* player, int steps){
+  player->move(steps);
+}
+void Board::teleportPlayer(Player* player, int destination){
+  if(destination >= 0 && destination < static_cast<int>(tiles.size())){
+    player->teleport(destination);
+  }
+  else{
+    errorOutput() << "invalid destination, no tile exists" << endl;
+    return;
+  }
+}
+
+void Board::sendToTimsLine(Player* player){
+  teleportPlayer(player, 10);  // Position 10 is the Tim's Line
+  player->enterTimsLine();
+}
+
+// Reads board.txt once and works out where each tile's piece slots are.
+// Every tile has a row of seven '*' slots; the coordinate table stores the
+// line and first column of that row, walking the board counter-clockwise
+// from Collect OSAP in the bottom-right corner.
+void Board::loadTemplate() {
+  templateLoaded = true;
+  ifstream boardFile{"board.txt"};
+  string line;
+  while (getline(boardFile, line)) {
+    boardTemplate.push_back(line);
+  }
+
+  // The bottom row of slots is the last line holding any; rows are five lines apart
+  const int side = static_cast<int>(tiles.size()) / 4;
+  int bottom = static_cast<int>(boardTemplate.size()) - 1;
+  while (bottom >= 0 && boardTemplate[bottom].find('*') == string::npos) {
+    --bottom;
+  }
+  tileCells.clear();
+  for (int pos = 0; pos < static_cast<int>(tiles.size()); ++pos) {
+    int edge = pos / side, step = pos % side, lineNo, column;
+    switch (edge) {
+      case 0: lineNo = bottom; column = 1 + (side - step) * 8; break;    // bottom row, right to left
+      case 1: lineNo = bottom - step * 5; column = 1; break;             // left column, upwards
+      case 2: lineNo = bottom - side * 5; column = 1 + step * 8; break;  // top row, left to right
+      default: lineNo = bottom - (side - step) * 5; column = 1 + side * 8; break; // right column, downwards
+    }
+    tileCells.emplace_back(lineNo, column);
+  }
+
+  // A template that does not match the board's shape is treated as missing
+  for (auto [lineNo, column] : tileCells) {
+    if (lineNo < 0 || column + 7 > static_cast<int>(boardTemplate[lineNo].size()) ||
+        boardTemplate[lineNo].compare(column, 7, "*******") != 0) {
+      errorOutput() << "Error: board.txt does not match the board layout" << endl;
+      boardTemplate.clear();
+      tileCells.clear();
+      return;
+    }
+  }
+}
+
+void Board::setDiffRendering(bool enabled) {
+  diffRendering = enabled;
+  lastFrame.clear();
+}
+
+void Board::display(std::span<Player* const> gamePlayers) {
+  if (!templateLoaded) {
+    loadTemplate();
+  }
+
+  // Create a simple text representation if the board file isn't available
+  if (boardTemplate.empty()) {
+    errorOutput() << "Error: Unable to open board.txt" << endl;
+    gameOutput() << "Creating a simple text representation instead." << endl;
+    
+    gameOutput() << "-----------------------------------------" << endl;
+    gameOutput() << "|   WATOPOLY BOARD - TEXT VERSION      |" << endl;
+    gameOutput() << "-----------------------------------------" << endl;
+
+    // Print positions of all tiles
+    for (int i = 0; i < static_cast<int>(tiles.size()); ++i) {
+      Tile* tile = getTile(i);
+      if (tile) {
+        gameOutput() << i << ": " << tile->getName();
+        
+        // List any players at this position
+        bool playersHere = false;
+        for (auto player : gamePlayers) {
+          if (player && player->getPosition() == i) {
+            if (!playersHere) {
+              gameOutput() << " - Players: ";
+              playersHere = true;
+            }
+            gameOutput() << player->getName() << "(" << player->getPiece() << ") ";
+          }
+        }
+        gameOutput() << endl;
+      }
+    }
+    
+    gameOutput() << "-----------------------------------------" << endl;
+    return;
+  }
+
+  // Place each piece in the first free slot of its tile
+  vector<string> frame = boardTemplate;
+  for (Player* player : gamePlayers) {
+    auto [lineNo, column] = tileCells[player->getPosition()];
+    for (int slot = column; slot < column + 7; ++slot) {
+      if (frame[lineNo][slot] == '*') {
+        frame[lineNo][slot] = player->getPiece();
+        break;
+      }
+    }
+  }
+
+  // Assemble the whole frame and hand it to the terminal in one write
+  string buffer;
+  if (diffRendering && lastFrame.size() == frame.size()) {
+    // Patch only the changed runs, then clear whatever was printed below the board
+    for (int row = 0; row < static_cast<int>(frame.size()); ++row) {
+      const string& now = frame[row];
+      const string& before = lastFrame[row];
+      for (int col = 0; col < static_cast<int>(now.size()); ++col) {
+        if (col < static_cast<int>(before.size()) && now[col] == before[col]) continue;
+        int end = col;
+        while (end < static_cast<int>(now.size()) &&
+               (end >= static_cast<int>(before.size()) || now[end] != before[end])) {
+          ++end;
+        }
+        buffer += "\x1b[" + to_string(row + 1) + ";" + to_string(col + 1) + "H";
+        buffer.append(now, col, end - col);
+        col = end;
+      }
+    }
+    buffer += "\x1b[" + to_string(frame.size() + 1) + ";1H\x1b[J";
+  } else {
+    if (diffRendering) {
+      buffer += "\x1b[H\x1b[2J"; // start from a clean screen so later patches line up
+    } else {
+      buffer += '\n';
+    }
+    for (const string& row : frame) {
+      buffer += row;
+      buffer += '\n';
+    }
+  }
+  output().write(buffer.data(), buffer.size());
+  output().flush();
+
+  if (diffRendering) {
+    lastFrame = std::move(frame);
+  }
+}
+
+//----------------------------------
+// GAME IMPLEMENTATIONS
+//----------------------------------
+
+Game::Game(bool testMode) : 
+  board(arena),
+  currentPlayerIndex(0),
+  rng(std::random_device{}()),
+  dice(testMode),
+  maxTimsCups(4),
+  isTestingMode(testMode),
+  decisions(&consoleDecisions),
+  currentTimsCupsInGame(0){
+  commandInterpreter = arena.make<CommandInterpreter>(this, isTestingMode);
+  seatsMark = arena.mark();
+}
+
+std::vector<Player*> Game::getPlayers() {
+return {players.begin(), players.end()};
+}
+
+
+void Game::initialize(int numPlayers, int botSeats) {
+// Initialize players, board, etc.
+if (numPlayers < 2 || numPlayers > 6) {
+    gameOutput() << "Invalid number of players. Please enter a number between 2 and 6." << std::endl;
+    return;
+}
+botSeats = std::clamp(botSeats, 0, numPlayers);
+
+std::vector<char> availablePieces = {'G','B','D','P','S','$','L','T'};
+std::vector<std::string> pieceNames = {"Goose", "Beer Bottle", "Donut", "Pink Tie", "Stetson", "Money", "Laptop", "T-Rex"};
+
+// Clear any existing players
+clearSeats();
+
+for (int i = 0; i < numPlayers - botSeats; ++i) {
+    std::string playerName;
+    char playerPiece;
+
+    gameOutput() << "Enter name for Player " << i + 1 << ": ";
+    std::cin >> playerName;
+
+    gameOutput() << "Available pieces: ";
+    size_t j;
+    for (j = 0; j < availablePieces.size(); ++j) {
+        gameOutput() << availablePieces[j] << " (" << pieceNames[j] << ") ";
+    }
+    gameOutput() << std::endl;
+
+    bool validPiece = false;
+    while (!validPiece) {
+        gameOutput() << "Enter piece for Player " << i + 1 << ": ";
+        std::cin >> playerPiece;
+
+        auto it = std::find(availablePieces.begin(), availablePieces.end(), playerPiece);
+        if (it != availablePieces.end()) {
+            availablePieces.erase(it);
+            pieceNames.erase(pieceNames.begin() + (it - availablePieces.begin()));
+            validPiece = true;
+        } else {
+            gameOutput() << "Invalid piece. Please choose from the available pieces." << std::endl;
+        }
+    }
+
+    players.push_back(addSeat(playerName, playerPiece));
+}
+
+// Bots take the pieces nobody chose, in the order they are listed
+for (int i = 0; i < botSeats; ++i) {
+    Player* player = addSeat("Bot" + std::to_string(i + 1), availablePieces[i]);
+    gameOutput() << player->getName() << " plays " << player->getPiece() << std::endl;
+    players.push_back(player);
+}
+
+currentPlayerIndex = 0;
+maxTimsCups = 4;
+currentTimsCupsInGame = 0;
+decisions->newGame();
+}
+
+// Non-interactive setup from a list of (name, piece) pairs; also resets the board
+void Game::initialize(const std::vector<std::pair<std::string, char>>& roster) {
+clearSeats();
+board.reset();
+
+for (const auto& [playerName, playerPiece] : roster) {
+    players.push_back(addSeat(playerName, playerPiece));
+}
+
+currentPlayerIndex = 0;
+maxTimsCups = 4;
+currentTimsCupsInGame = 0;
+decisions->newGame();
+}
+
+// Change to static method per declaration
+void Game::loadGame(std::string filename) {
+ScopedTimer timer{metrics.loadTime};
+std::ifstream file(filename);
+if (!file.is_open()) {
+    errorOutput() << "Error opening file: " << filename << std::endl;
+    return;
+}
+
+// Binary snapshots are recognised by their tag
+std::uint32_t tag = 0;
+if (file.read(reinterpret_cast<char*>(&tag), sizeof(tag)) && tag == SnapshotHeader::magic) {
+    file.close();
+    try {
+        loadSnapshot(filename);
+    } catch (const exception& e) {
+        errorOutput() << "Error loading " << filename << ": " << e.what() << std::endl;
+    }
+    return;
+}
+file.clear();
+file.seekg(0);
+
+// Clear existing game state
+clearSeats();
+board.reset();
+currentTimsCupsInGame = 0;
+
+int numPlayers;
+file >> numPlayers;
+file.ignore(); // Consume the newline character
+
+for (int i = 0; i < numPlayers; ++i) {
+    std::string line;
+    std::getline(file, line);
+    std::stringstream ss(line);
+
+    std::string playerName;
+    char playerPiece;
     int timsCups;
     int money;
     int position;
     int inTimsLineStatus = 0;
     int turnsInTimsLine = 0;
 
-    ss >> playerName >> playerPiece >> timsCups >> money >> position;
+    ss >> playerName >> playerPiece >> timsCups >> money >> position;
+
+    if (position == 10) {
+        // Check if there's another value (inTimsLineStatus)
+        if (ss >> inTimsLineStatus) {
+            if (inTimsLineStatus == 1) {
+                // If inTimsLineStatus is 1, there's a number of turns
+                ss >> turnsInTimsLine;
+            }
+        }
+    }
+
+    // Restore the saved values directly; cups already in hand count towards the cap
+    Player* player = addSeat(playerName, playerPiece);
+    bool inLine = position == 10 && inTimsLineStatus == 1;
+    player->restoreState(playerPiece, money, position, inLine, inLine ? turnsInTimsLine : 0, timsCups);
+    currentTimsCupsInGame += timsCups;
+    
+    players.push_back(player);
+}
+
+// Load property information
+std::string line;
+while (std::getline(file, line)) {
+    std::stringstream ss(line);
+    std::string propertyName, ownerName;
+    int improvements;
+    
+    ss >> propertyName >> ownerName >> improvements;
+    
+    Property* property = board.findProperty(propertyName);
+    if (!property) {
+        errorOutput() << "Error: Property " << propertyName << " not found." << std::endl;
+        continue;
+    }
+    
+    if (ownerName != "BANK") {
+        Player* owner = getPlayerByName(ownerName);
+        
+        if (!owner) {
+            errorOutput() << "Error: Player " << ownerName << " not found." << std::endl;
+            continue;
+        }
+        
+        // Set the owner and add to player's properties
+        owner->acquireProperty(property);
+        
+        // Handle mortgages and improvements
+        if (improvements == -1) {
+            property->setMortgaged(true);
+        } else if (improvements > 0) {
+            // Only academic buildings can have improvements
+            AcademicBuilding* academic = asAcademicBuilding(property);
+            if (academic) {
+                academic->setImprovements(std::min(improvements, 5));
+            }
+        }
+    }
+}
+
+currentPlayerIndex = 0; // Start with the first player
+file.close();
+}
+
+void Game::saveState(GameState& state) const {
+if (seats.size() > GameState::maxPlayers) {
+    throw length_error("GameState holds at most 8 seats");
+}
+state = GameState{};
+rng.saveState(state.rng);
+
+state.numSeats = seats.size();
+for (size_t seat = 0; seat < seats.size(); ++seat) {
+    const Player* player = seats[seat];
+    state.cash[seat] = player->getMoney();
+    state.position[seat] = player->getPosition();
+    state.playerFlags[seat] = (player->isInTimsLine() ? GameState::inTimsLine : 0) |
+                              (isActive(player) ? 0 : GameState::bankrupt);
+    state.turnsInTimsLine[seat] = player->getTurnsInTimsLine();
+    state.timsCups[seat] = player->getTimsCups();
+    state.piece[seat] = player->getPiece();
+    if (player == getCurrentPlayer()) {
+        state.currentPlayer = seat;
+    }
+}
+
+// Tiles past the end of a smaller board stay bank-owned with no flags
+std::fill(std::begin(state.owner), std::end(state.owner), GameState::noOwner);
+for (int i = 0; i < board.getTileCount(); ++i) {
+    Property* property = asProperty(board.getTile(i));
+    if (!property || !property->getOwner()) continue;
+
+    state.owner[i] = std::find(seats.begin(), seats.end(), property->getOwner()) - seats.begin();
+    AcademicBuilding* academic = asAcademicBuilding(property);
+    state.tileFlags[i] = (property->isMortgaged() ? GameState::mortgaged : 0) |
+                         (academic ? academic->getImprovements() : 0);
+}
+state.cupsInGame = currentTimsCupsInGame;
+}
+
+// Rejects anything loadState could not apply to this board: seat and tile indices
+// out of range, unknown flags, and improvements a building cannot hold.
+void Game::checkState(const GameState& state) const {
+if (state.numSeats < 2 || state.numSeats > 6) {
+    throw runtime_error("state seats " + std::to_string(state.numSeats) + " players, not 2 to 6");
+}
+if (state.currentPlayer >= state.numSeats) {
+    throw runtime_error("state's current player is not seated");
+}
+for (int seat = 0; seat < state.numSeats; ++seat) {
+    if (!std::isgraph(static_cast<unsigned char>(state.piece[seat]))) {
+        throw runtime_error("seat " + std::to_string(seat) + " has no piece");
+    }
+    if (state.position[seat] >= board.getTileCount()) {
+        throw runtime_error("seat " + std::to_string(seat) + " is off the board");
+    }
+    if (state.playerFlags[seat] & ~(GameState::inTimsLine | GameState::bankrupt)) {
+        throw runtime_error("seat " + std::to_string(seat) + " has unknown flags");
+    }
+}
+for (int i = 0; i < GameState::numTiles; ++i) {
+    const std::string tile = "tile " + std::to_string(i);
+    if (state.owner[i] == GameState::noOwner) {
+        if (state.tileFlags[i] != 0) {
+            throw runtime_error(tile + " is mortgaged or improved without an owner");
+        }
+        continue;
+    }
+    if (state.owner[i] >= state.numSeats) {
+        throw runtime_error(tile + " is owned by an empty seat");
+    }
+    Property* property = i < board.getTileCount() ? asProperty(board.getTile(i)) : nullptr;
+    if (!property) {
+        throw runtime_error(tile + " cannot be owned");
+    }
+    const int improvements = state.tileFlags[i] & 0x0f;
+    if (state.tileFlags[i] & ~(GameState::mortgaged | 0x0f)) {
+        throw runtime_error(tile + " has unknown flags");
+    }
+    if (improvements > 0 && (!asAcademicBuilding(property) || improvements > 5)) {
+        throw runtime_error(tile + " has " + std::to_string(improvements) + " improvements");
+    }
+    if (improvements > 0 && (state.tileFlags[i] & GameState::mortgaged)) {
+        throw runtime_error(tile + " is both mortgaged and improved");
+    }
+}
+}
+
+// Restores a captured state. Seats keep their names when the seat count matches,
+// otherwise they are recreated as Player1..n. Holdings come back in board order.
+void Game::loadState(const GameState& state) {
+checkState(state);
+if (seats.size() != state.numSeats) {
+    clearSeats();
+    for (int seat = 0; seat < state.numSeats; ++seat) {
+        addSeat("Player" + std::to_string(seat + 1), state.piece[seat]);
+    }
+}
+
+players.clear();
+currentPlayerIndex = 0;
+for (int seat = 0; seat < state.numSeats; ++seat) {
+    Player* player = seats[seat];
+    player->restoreState(state.piece[seat], state.cash[seat], state.position[seat],
+                         state.playerFlags[seat] & GameState::inTimsLine,
+                         state.turnsInTimsLine[seat], state.timsCups[seat]);
+    if (state.playerFlags[seat] & GameState::bankrupt) continue;
+    if (seat == state.currentPlayer) {
+        currentPlayerIndex = players.size();
+    }
+    players.push_back(player);
+}
+
+for (int i = 0; i < board.getTileCount(); ++i) {
+    Property* property = asProperty(board.getTile(i));
+    if (!property) continue;
+
+    property->reset();
+    if (state.owner[i] == GameState::noOwner) continue;
+    seats[state.owner[i]]->acquireProperty(property);
+    property->setMortgaged(state.tileFlags[i] & GameState::mortgaged);
+    if (AcademicBuilding* academic = asAcademicBuilding(property)) {
+        academic->setImprovements(state.tileFlags[i] & 0x0f);
+    }
+}
+
+currentTimsCupsInGame = state.cupsInGame;
+rng.loadState(state.rng);
+}
+
+namespace {
+  std::uint64_t fnv1a(const char* data, std::size_t size) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+      hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+    }
+    return hash;
+  }
+}
+
+void Game::writeSnapshot(std::string& buffer) const {
+GameState state;
+saveState(state);
+
+buffer.assign(sizeof(SnapshotHeader), '\0');
+buffer.append(reinterpret_cast<const char*>(&state), sizeof(state));
+for (int seat = 0; seat < state.numSeats; ++seat) {
+    const std::string& name = seats[seat]->getName();
+    if (name.size() > 255) {
+        throw length_error("Player names in a snapshot are limited to 255 characters");
+    }
+    buffer.push_back(static_cast<char>(name.size()));
+    buffer.append(name);
+}
+
+SnapshotHeader header{};
+header.tag = SnapshotHeader::magic;
+header.version = SnapshotHeader::currentVersion;
+header.stateSize = sizeof(GameState);
+header.payloadSize = buffer.size() - sizeof(SnapshotHeader);
+header.checksum = fnv1a(buffer.data() + sizeof(SnapshotHeader), header.payloadSize);
+std::memcpy(buffer.data(), &header, sizeof(header));
+}
+
+void Game::readSnapshot(const char* data, std::size_t size) {
+SnapshotHeader header;
+if (size < sizeof(header)) {
+    throw runtime_error("snapshot is truncated");
+}
+std::memcpy(&header, data, sizeof(header));
+if (header.tag != SnapshotHeader::magic) {
+    throw runtime_error("not a snapshot file");
+}
+if (header.version != SnapshotHeader::currentVersion || header.stateSize != sizeof(GameState)) {
+    throw runtime_error("unsupported snapshot version " + std::to_string(header.version));
+}
+if (header.payloadSize != size - sizeof(header) || header.payloadSize < sizeof(GameState)) {
+    throw runtime_error("snapshot is truncated");
+}
+const char* payload = data + sizeof(header);
+if (fnv1a(payload, header.payloadSize) != header.checksum) {
+    throw runtime_error("snapshot checksum mismatch");
+}
+
+GameState state;
+std::memcpy(&state, payload, sizeof(state));
+checkState(state);
+
+// Seat the saved players first so loadState keeps their names
+const char* cursor = payload + sizeof(state);
+const char* end = payload + header.payloadSize;
+std::vector<std::string> names;
+for (int seat = 0; seat < state.numSeats; ++seat) {
+    if (cursor == end || end - cursor - 1 < static_cast<unsigned char>(*cursor)) {
+        throw runtime_error("snapshot is truncated");
+    }
+    std::size_t length = static_cast<unsigned char>(*cursor++);
+    names.emplace_back(cursor, length);
+    cursor += length;
+}
+clearSeats();
+for (int seat = 0; seat < state.numSeats; ++seat) {
+    addSeat(names[seat], state.piece[seat]);
+}
+loadState(state);
+}
+
+void Game::saveSnapshot(const std::string& filename) const {
+ScopedTimer timer{metrics.saveTime};
+std::string buffer;
+writeSnapshot(buffer);
+std::ofstream file(filename, std::ios::binary);
+if (!file.write(buffer.data(), buffer.size())) {
+    throw runtime_error("cannot write " + filename);
+}
+}
+
+void Game::loadSnapshot(const std::string& filename) {
+std::ifstream file(filename, std::ios::binary);
+if (!file.is_open()) {
+    throw runtime_error("cannot open " + filename);
+}
+std::string buffer{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+readSnapshot(buffer.data(), buffer.size());
+}
+
+void Game::removeBankruptPlayer(Player* bankruptPlayer) {
+// Find the player in the list and remove them
+auto it = std::find(players.begin(), players.end(), bankruptPlayer);
+if (it != players.end()) {
+  metrics.bankruptcies++;
+  int index = it - players.begin();
+  bool wasCurrent = index == currentPlayerIndex;
+  
+  // Remove the player from the list; the object stays in seats because the
+  // turn that bankrupted them may still be holding a pointer to it
+  players.erase(it);
+  
+  // Keep the turn order: whoever sat after the bankrupt player is now at their index
+  if (index < currentPlayerIndex) {
+    currentPlayerIndex--;
+  }
+  if (currentPlayerIndex >= static_cast<int>(players.size())) {
+    currentPlayerIndex = 0;
+  }
+  
+  // Check if the game should end
+  if (players.size() <= 1) {
+    endGame();
+  } else if (wasCurrent) {
+    gameOutput() << "Next player: " << players[currentPlayerIndex]->getName() << std::endl;
+  }
+}
+}
+
+void Game::setDecisionProvider(DecisionProvider* provider) {
+decisions = provider ? provider : &consoleDecisions;
+}
+
+bool Game::isActive(const Player* player) const {
+return std::find(players.begin(), players.end(), player) != players.end();
+}
+
+void Game::saveGame(std::string filename) {
+ScopedTimer timer{metrics.saveTime};
+std::ofstream file(filename);
+if (!file.is_open()) {
+    errorOutput() << "Error opening file: " << filename << std::endl;
+    return;
+}
+
+// Save number of players
+file << players.size() << std::endl;
+
+// Save player information
+for (auto player : players) {
+    file << player->getName() << " "
+         << player->getPiece() << " "
+         << player->getTimsCups() << " "
+         << player->getMoney() << " "
+         << player->getPosition();
+
+    // Handle DC Tims Line
+    if (player->getPosition() == 10) {
+        if (player->isInTimsLine()) {
+            file << " 1 " << player->getTurnsInTimsLine();
+        } else {
+            file << " 0";
+        }
+    }
+
+    file << std::endl;
+}
+
+// Save property information
+// We need to go through all properties in board order
+for (int i = 0; i < 40; i++) {
+  Tile* tile = board.getTile(i);
+  if (!tile) continue;
+
+  Property* property = asProperty(tile);
+  if (!property) continue; // Skip non-property tiles
+
+  // Write property name
+  file << property->getName() << " ";
+
+  // Write owner
+  if (property->getOwner()) {
+      file << property->getOwner()->getName() << " ";
+  } else {
+      file << "BANK" << " ";
+  }
+
+  // Write improvements or mortgage status
+  if (property->isMortgaged()) {
+      file << "-1";
+  } else {
+      // Check if it's an academic building with improvements
+      AcademicBuilding* academic = asAcademicBuilding(property);
+      if (academic) {
+          file << academic->getImprovements();
+      } else {
+          file << "0"; // Residences and Gyms always have 0 improvements
+      }
+  }
+
+  file << std::endl;
+}
+
+file.close();
+}
+
+void Game::nextPlayer() {
+// Move to the next player
+currentPlayerIndex = (currentPlayerIndex + 1) % players.size();
+gameOutput() << "Next player: " << players[currentPlayerIndex]->getName() << std::endl;
+}
+
+void Game::processCommand(std::string command) {
+commandInterpreter->parseCommand(command);
+}
+
+void Game::addCommandLog(CommandLog* log) {
+commandLogs.push_back(log);
+}
+
+void Game::removeCommandLog(CommandLog* log) {
+commandLogs.erase(std::remove(commandLogs.begin(), commandLogs.end(), log), commandLogs.end());
+}
+
+void Game::endGame() {
+// End the game and declare the winner
+if (players.size() == 1) {
+    gameOutput() << "Game over! Winner: " << players[0]->getName() << "!" << endl;
+} else {
+    gameOutput() << "Game ended with multiple players still active." << endl;
+}
+}
+
+void Game::auctionProperty(Property* property) {
+// Everyone still in the game bids in turn order until a single bidder holds the highest bid
+metrics.auctions++;
+gameOutput() << "Starting auction for " << property->getName() << std::endl;
+int highestBid = 0;
+Player* highestBidder = nullptr;
+FixedVector<Player*, maxPieces> bidders = players;
+size_t turn = 0;
+while (!bidders.empty() && !(bidders.size() == 1 && bidders[0] == highestBidder)) {
+    turn %= bidders.size();
+    Player* bidder = bidders[turn];
+    if (bidder == highestBidder) {
+        turn++;
+        continue;
+    }
+    
+    gameOutput() << "Current highest bid: " << highestBid << " by ";
+    if (highestBidder) {
+        gameOutput() << highestBidder->getName();
+    } else {
+        gameOutput() << "none";
+    }
+    gameOutput() << std::endl;
+    gameOutput() << bidder->getName() << ", enter your bid or 'pass': ";
+    
+    int bid = decisions->bid(bidder, property, highestBid);
+    if (bid > highestBid && bidder->canPayAmount(bid)) {
+        highestBid = bid;
+        highestBidder = bidder;
+        turn++;
+    } else {
+        if (bid > highestBid) {
+            gameOutput() << "You cannot afford a bid of $" << bid << "." << std::endl;
+        }
+        gameOutput() << bidder->getName() << " drops out of the auction." << std::endl;
+        bidders.erase(bidders.begin() + turn);
+    }
+}
+
+if (highestBidder) {
+    gameOutput() << highestBidder->getName() << " won the auction for " << highestBid << "!" << std::endl;
+    highestBidder->payMoneyToBank(*this, highestBid);
+    highestBidder->acquireProperty(property);
+} else {
+    gameOutput() << "No one won the auction." << std::endl;
+}
+}
+
+int Game::getSeat(const Player* player) const {
+  auto it = seatIndex.find(player->getName());
+  if (it == seatIndex.end() || seats[it->second] != player) {
+    return -1;
+  }
+  return it->second;
+}
+
+int Game::getNumPlayers() const {
+return players.size();
+}
+
+bool Game::canGiveMoreCups() {
+if(maxTimsCups > currentTimsCupsInGame){
+  return true;
+}
+return false;
+}
+
+Player* Game::getCurrentPlayer() const {
+  if(players.empty() || currentPlayerIndex >= players.size()){ 
+    return nullptr; 
+  }
+  return players[currentPlayerIndex];
+}
+
+// Added getters needed by CommandInterpreter
+Dice& Game::getDice() {
+  return dice;
+}
+
+Board& Game::getBoard() {
+  return board;
+}
+
+Player* Game::getPlayerByName(const string& name) {
+  auto it = seatIndex.find(name);
+  if (it == seatIndex.end()) {
+    return nullptr;
+  }
+  Player* player = seats[it->second];
+  return isActive(player) ? player : nullptr;
+}
+
+// Frees every seated player in one step and empties the name index
+void Game::clearSeats() {
+  seats.clear();
+  seatIndex.clear();
+  players.clear();
+  arena.rewind(seatsMark);
+}
+
+Player* Game::addSeat(const std::string& name, char piece) {
+  if (seats.size() == seats.capacity()) {
+    throw length_error("a game seats at most " + std::to_string(maxPieces) + " players");
+  }
+  Player* player = arena.make<Player>(name, piece, board);
+  seatIndex.emplace(name, seats.size()); // first seat wins, as the old scan did
+  seats.push_back(player);
+  return player;
+}
+
+// Resolves the current player's roll using whatever is on the dice:
+// Tims Line rules, movement, landing and passing the turn
+void Game::playRoll() {
+// Get the current player and move them
+Player* currentPlayer = getCurrentPlayer();
+if (!currentPlayer) {
+    gameOutput() << "Error: No current player" << endl;
+    return;
+}
+
+int steps = dice.getTotal();
+
+// Check if player is in Tims Line
+if (currentPlayer->isInTimsLine()) {
+    if (dice.isDoubles()) {
+        gameOutput() << currentPlayer->getName() << " rolled doubles and is leaving Tims Line!" << endl;
+        currentPlayer->leaveTimsLine();
+    } else {
+        gameOutput() << currentPlayer->getName() << " is in Tims Line and did not roll doubles." << endl;
+        
+        // PROMPT THE PLAYER TO USE A CUP OR PAY REGARDLESS OF TURNS
+        bool hasRimCup = currentPlayer->getTimsCups() > 0;
+        int turnsInTimsLine = currentPlayer->getTurnsInTimsLine();
+        
+        // If it's their third turn or later, they MUST leave
+        bool mustLeave = (turnsInTimsLine >= 2);
+        
+        if (hasRimCup) {
+            gameOutput() << "Do you want to use a Roll Up the Rim cup to leave? (y/n): ";
+            if (decisions->useTimsCup(currentPlayer)) {
+                currentPlayer->useTimsCup();
+                gameOutput() << "Used a Roll Up the Rim cup to leave Tims Line!" << endl;
+                currentPlayer->leaveTimsLine();
+            } else if (mustLeave) {
+                // On third turn, must pay if they don't use a cup
+                gameOutput() << "This is your third turn in Tims Line. You must pay $50 to leave." << endl;
+                if (currentPlayer->payMoneyToBank(*this, 50)) {
+                    gameOutput() << "Paid $50 to leave Tims Line." << endl;
+                    currentPlayer->leaveTimsLine();
+                } else {
+                    gameOutput() << "Cannot pay $50. You must trade, mortgage, or declare bankruptcy." << endl;
+                    return;
+                }
+            } else {
+                // Not third turn, give option to pay or stay
+                gameOutput() << "Do you want to pay $50 to leave? (y/n): ";
+                if (decisions->payToLeaveTims(currentPlayer)) {
+                    if (currentPlayer->payMoneyToBank(*this, 50)) {
+                        gameOutput() << "Paid $50 to leave Tims Line." << endl;
+                        currentPlayer->leaveTimsLine();
+                    } else {
+                        gameOutput() << "Cannot pay $50. You must trade, mortgage, or declare bankruptcy." << endl;
+                        return;
+                    }
+                } else {
+                    // Stay in Tims Line
+                    currentPlayer->incrementTurnsInTimsLine();
+                    gameOutput() << "Staying in Tims Line. Turn ended." << endl;
+                    nextPlayer();
+                    return;
+                }
+            }
+        } else {
+            // No Rim Cup, check if must pay or can choose
+            if (mustLeave) {
+                gameOutput() << "This is your third turn in Tims Line. You must pay $50 to leave." << endl;
+                if (currentPlayer->payMoneyToBank(*this, 50)) {
+                    gameOutput() << "Paid $50 to leave Tims Line." << endl;
+                    currentPlayer->leaveTimsLine();
+                } else {
+                    gameOutput() << "Cannot pay $50. You must trade, mortgage, or declare bankruptcy." << endl;
+                    return;
+                }
+            } else {
+                // Not third turn, give option to pay or stay
+                gameOutput() << "Do you want to pay $50 to leave? (y/n): ";
+                if (decisions->payToLeaveTims(currentPlayer)) {
+                    if (currentPlayer->payMoneyToBank(*this, 50)) {
+                        gameOutput() << "Paid $50 to leave Tims Line." << endl;
+                        currentPlayer->leaveTimsLine();
+                    } else {
+                        gameOutput() << "Cannot pay $50. You must trade, mortgage, or declare bankruptcy." << endl;
+                        return;
+                    }
+                } else {
+                    // Stay in Tims Line
+                    currentPlayer->incrementTurnsInTimsLine();
+                    gameOutput() << "Staying in Tims Line. Turn ended." << endl;
+                    nextPlayer();
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// Move the player - this happens if they're not in Tims Line or just left it
+int oldPosition = currentPlayer->getPosition();
+board.movePlayer(currentPlayer, steps);
+int newPosition = currentPlayer->getPosition();
+
+gameOutput() << currentPlayer->getName() << " moved from " << oldPosition 
+     << " to " << newPosition << endl;
+
+// Get the tile and handle landing
+Tile* tile = board.getTile(newPosition);
+if (tile) {
+    bool wasInTimsLine = currentPlayer->isInTimsLine();
+    board.landOn(*this, tile, currentPlayer);
+    if (!wasInTimsLine && currentPlayer->isInTimsLine()) {
+        metrics.timsLineEntries++;
+    }
+}
+
+// Landing may have bankrupted the player, in which case their turn is already over
+if (!isActive(currentPlayer)) {
+    return;
+}
+
+// If we rolled doubles, player gets another turn unless they're in Tims Line
+if (dice.isDoubles() && !currentPlayer->isInTimsLine()) {
+    gameOutput() << "Rolled doubles! " << currentPlayer->getName() << " gets another turn." << endl;
+} else {
+    nextPlayer();
+}
+}
+
+// Plays turns back to back until one player is left or maxTurns rolls have been made.
+// Nothing is rendered; every choice goes to the current decision provider.
+GameResult Game::runHeadless(int maxTurns) {
+int turns = 0;
+while (players.size() > 1 && turns < maxTurns) {
+  Player* current = getCurrentPlayer();
+  while (AcademicBuilding* building = decisions->chooseImprovement(current)) {
+    if (!current->buyImprovement(building)) break;
+  }
+  dice.roll(rng);
+  playRoll();
+  // Doubles give the same player another roll within the turn
+  if (!(dice.isDoubles() && isActive(current) && getCurrentPlayer() == current)) {
+    turns++;
+  }
+}
+
+GameResult result{"", players.size() == 1, turns, {}};
+Player* winner = players.empty() ? nullptr : players[0];
+int bestWorth = winner ? winner->getNetWorth() : 0;
+for (auto player : players) {
+  int worth = player->getNetWorth();
+  if (worth > bestWorth) {
+    winner = player;
+    bestWorth = worth;
+  }
+}
+if (winner) {
+  result.winner = winner->getName();
+  result.winnerSeat = getSeat(winner);
+}
+for (auto player : seats) {
+  result.balances.emplace_back(player->getName(), player->getMoney());
+  result.netWorths.push_back(isActive(player) ? player->getNetWorth() : 0);
+}
+
+return result;
+}
 
-    if (position == 10) {
-        // Check if there's another value (inTimsLineStatus)
-        if (ss >> inTimsLineStatus) {
-            if (inTimsLineStatus == 1) {
-                // If inTimsLineStatus is 1, there's a number of turns
-                ss >> turnsInTimsLine;
-            }
+void Game::mainLoop() {
+bool gameOver = false;
+
+while (!gameOver) {
+  // Check for game ending conditions
+  if (players.size() <= 1) {
+    gameOver = true;
+    continue;
+  }
+  // Display board state
+  {
+    ScopedTimer timer{metrics.displayTime};
+    board.display(players);
+  }
+  
+  // Display current player's assets
+  Player* currentPlayer = getCurrentPlayer();
+  gameOutput() << "Current player: " << currentPlayer->getName() << std::endl;
+  gameOutput() << "Assets: " << currentPlayer->getAssets() << std::endl;
+  
+  if (decisions->controlsTurn(currentPlayer)) {
+    playBotTurn(currentPlayer);
+    continue;
+  }
+  
+  // Process commands for the current player
+  std::string command;
+  gameOutput() << "> ";
+  if (!std::getline(std::cin, command)) {
+    // End of a command script behaves like quit
+    gameOver = true;
+    continue;
+  }
+  
+  if (command == "quit") {
+    gameOver = true;
+  } else {
+    runCommand(command);
+  }
+  
+  
+}
+
+endGame();
+metrics.report(output(), board);
+}
+
+// Processes one command with every command log watching
+void Game::runCommand(const std::string& command) {
+for (CommandLog* log : commandLogs) log->begin();
+processCommand(command);
+for (CommandLog* log : commandLogs) log->commit(command);
+}
+
+// Bots play through the commands a person would type, so journals and recordings cover them too
+void Game::playBotTurn(Player* bot) {
+while (AcademicBuilding* building = decisions->chooseImprovement(bot)) {
+  int before = building->getImprovements();
+  std::string command = "improve " + building->getName() + " buy";
+  gameOutput() << "> " << command << std::endl;
+  runCommand(command);
+  if (building->getImprovements() == before) break;
+}
+gameOutput() << "> roll" << std::endl;
+runCommand("roll");
+}
+
+//-----------------------------------
+// COMMAND INTERPRETER IMPLEMENTATIONS
+//-----------------------------------
+
+CommandInterpreter::CommandInterpreter(Game* game, bool testingMode) 
+  : game(game), testingMode(testingMode) {}
+
+void CommandInterpreter::parseCommand(const string& command) {
+  // Tokenize the command
+  vector<string> tokens = tokenizeCommand(command);
+  
+  if (tokens.empty()) {
+    return;
+  }
+  
+  string action = tokens[0];
+  vector<string> args(tokens.begin() + 1, tokens.end());
+  
+  Metrics::Verb verb = Metrics::verbOf(action);
+  Metrics& metrics = game->getMetrics();
+  metrics.commands[verb]++;
+  ScopedTimer timer{metrics.commandTime[verb]};
+  
+  // Execute appropriate command
+  if (action == "roll") {
+    executeRoll(args);
+  } else if (action == "next") {
+    executeNext();
+  } else if (action == "trade") {
+    executeTrade(args);
+  } else if (action == "improve") {
+    executeImprove(args);
+  } else if (action == "mortgage") {
+    executeMortgage(args);
+  } else if (action == "unmortgage") {
+    executeUnmortgage(args);
+  } else if (action == "bankrupt") {
+    executeBankrupt();
+  } else if (action == "assets") {
+    executeAssets();
+  } else if (action == "all") {
+    executeAll();
+  } else if (action == "save") {
+    executeSave(args);
+  } else if (action == "stats") {
+    executeStats();
+  } else {
+    gameOutput() << "Invalid command: " << action << endl;
+  }
+}
+
+vector<string> CommandInterpreter::tokenizeCommand(const string& command) {
+  vector<string> tokens;
+  istringstream iss(command);
+  string token;
+  
+  while (iss >> token) {
+    tokens.push_back(token);
+  }
+  
+  return tokens;
+}
+
+void CommandInterpreter::executeRoll(const vector<string>& args) {
+if (testingMode && args.size() == 2) {
+    // In testing mode, we can specify the dice values
+    try {
+        int die1 = stoi(args[0]);
+        int die2 = stoi(args[1]);
+        
+        if (die1 < 0 || die2 < 0) {
+            throw out_of_range("Dice values must be non-negative");
         }
+        
+        Dice& dice = game->getDice();
+        dice.setTestDice(die1, die2);
+        gameOutput() << "Rolling " << die1 << " and " << die2 << " (testing mode)" << endl;
+    } catch (const exception& e) {
+        gameOutput() << "Error: " << e.what() << endl;
+        return;
     }
+} else if (!args.empty()) {
+    gameOutput() << "Error: Invalid arguments for roll command" << endl;
+    return;
+} else {
+    // Normal roll
+    Dice& dice = game->getDice();
+    dice.roll(game->getRng());
+    gameOutput() << "Rolled " << dice.getTotal() << endl;
+}
 
-    Player* player = new Player(playerName, playerPiece);
+game->playRoll();
+}
+
+
+void CommandInterpreter::executeNext() {
+  game->nextPlayer();
+  gameOutput() << "Turn passed to " << game->getCurrentPlayer()->getName() << endl;
+}
+
+void CommandInterpreter::executeTrade(const vector<string>& args) {
+if (args.size() != 3) {
+    gameOutput() << "Error: Invalid trade command. Use: trade <name> <give> <receive>" << endl;
+    return;
+}
+
+string targetPlayerName = args[0];
+string give = args[1];
+string receive = args[2];
+
+// Find the target player
+Player* currentPlayer = game->getCurrentPlayer();
+Player* targetPlayer = game->getPlayerByName(targetPlayerName);
+
+if (!targetPlayer) {
+    gameOutput() << "Error: Player " << targetPlayerName << " not found." << endl;
+    return;
+}
+
+// Check if both are money (not allowed)
+bool giveIsMoney = utilities::isNumeric(give);
+bool receiveIsMoney = utilities::isNumeric(receive);
+
+if (giveIsMoney && receiveIsMoney) {
+    gameOutput() << "Error: Cannot trade money for money." << endl;
+    return;
+}
+
+// Handle property for property trade
+if (!giveIsMoney && !receiveIsMoney) {
+    // Find the properties
+    Property* giveProperty = game->getBoard().getPropertyByName(give);
+    Property* receiveProperty = game->getBoard().getPropertyByName(receive);
+    
+    if (!giveProperty || !receiveProperty) {
+        gameOutput() << "Error: One or both properties not found." << endl;
+        return;
+    }
+    
+    // Check ownership
+    if (giveProperty->getOwner() != currentPlayer) {
+        gameOutput() << "Error: You don't own " << give << "." << endl;
+        return;
+    }
+    
+    if (receiveProperty->getOwner() != targetPlayer) {
+        gameOutput() << "Error: " << targetPlayerName << " doesn't own " << receive << "." << endl;
+        return;
+    }
+    
+    // Check for improvements on the property or in the monopoly
+    AcademicBuilding* giveAcademic = asAcademicBuilding(giveProperty);
+    if (giveAcademic) {
+        // Check if property has improvements
+        if (giveAcademic->getImprovements() > 0) {
+            gameOutput() << "Error: Cannot trade " << give << " as it has improvements. Sell improvements first." << endl;
+            return;
+        }
+        
+        // Check if any property in the monopoly has improvements
+        if (currentPlayer->ownsMonopoly(giveAcademic)) {
+            for (const auto& prop : currentPlayer->getProperties()) {
+                AcademicBuilding* academic = asAcademicBuilding(prop);
+                if (academic && academic->getBlockId() == giveAcademic->getBlockId() && academic->getImprovements() > 0) {
+                    gameOutput() << "Error: Cannot trade " << give << " as a property in its monopoly has improvements." << endl;
+                    return;
+                }
+            }
+        }
+    }
+    
+    // Same checks for receive property
+    AcademicBuilding* receiveAcademic = asAcademicBuilding(receiveProperty);
+    if (receiveAcademic) {
+        if (receiveAcademic->getImprovements() > 0) {
+            gameOutput() << "Error: Cannot trade " << receive << " as it has improvements." << endl;
+            return;
+        }
+        
+        if (targetPlayer->ownsMonopoly(receiveAcademic)) {
+            for (const auto& prop : targetPlayer->getProperties()) {
+                AcademicBuilding* academic = asAcademicBuilding(prop);
+                if (academic && academic->getBlockId() == receiveAcademic->getBlockId() && academic->getImprovements() > 0) {
+                    gameOutput() << "Error: Cannot trade " << receive << " as a property in its monopoly has improvements." << endl;
+                    return;
+                }
+            }
+        }
+    }
+    
+    // Offer the trade to the target player
+    string offer = "your " + receive + " for " + currentPlayer->getName() + "'s " + give;
+    gameOutput() << "Trade offered to " << targetPlayerName << ": " << offer << endl;
+    gameOutput() << targetPlayerName << ", do you accept this trade? (accept/reject): ";
+    
+    if (game->getDecisions().acceptTrade(targetPlayer, offer)) {
+        // Swap property ownership
+        currentPlayer->releaseProperty(giveProperty);
+        targetPlayer->releaseProperty(receiveProperty);
+        currentPlayer->acquireProperty(receiveProperty);
+        targetPlayer->acquireProperty(giveProperty);
+        
+        gameOutput() << "Trade completed successfully!" << endl;
+    } else {
+        gameOutput() << "Trade rejected." << endl;
+    }
+}
+// Handle money for property trade (currentPlayer gives money)
+else if (giveIsMoney && !receiveIsMoney) {
+    int amount = stoi(give);
+    Property* receiveProperty = game->getBoard().getPropertyByName(receive);
+    
+    if (!receiveProperty) {
+        gameOutput() << "Error: Property " << receive << " not found." << endl;
+        return;
+    }
+    
+    // Check ownership
+    if (receiveProperty->getOwner() != targetPlayer) {
+        gameOutput() << "Error: " << targetPlayerName << " doesn't own " << receive << "." << endl;
+        return;
+    }
+    
+    // Check if current player has enough money
+    if (!currentPlayer->canPayAmount(amount)) {
+        gameOutput() << "Error: You don't have enough money for this trade." << endl;
+        return;
+    }
+    
+    // Check for improvements on the property or in the monopoly
+    AcademicBuilding* receiveAcademic = asAcademicBuilding(receiveProperty);
+    if (receiveAcademic) {
+        if (receiveAcademic->getImprovements() > 0) {
+            gameOutput() << "Error: Cannot trade " << receive << " as it has improvements." << endl;
+            return;
+        }
+        
+        if (targetPlayer->ownsMonopoly(receiveAcademic)) {
+            for (const auto& prop : targetPlayer->getProperties()) {
+                AcademicBuilding* academic = asAcademicBuilding(prop);
+                if (academic && academic->getBlockId() == receiveAcademic->getBlockId() && academic->getImprovements() > 0) {
+                    gameOutput() << "Error: Cannot trade " << receive << " as a property in its monopoly has improvements." << endl;
+                    return;
+                }
+            }
+        }
+    }
+    
+    // Offer the trade to the target player
+    string offer = "your " + receive + " for $" + to_string(amount);
+    gameOutput() << "Trade offered to " << targetPlayerName << ": " << offer << endl;
+    gameOutput() << targetPlayerName << ", do you accept this trade? (accept/reject): ";
+    
+    if (game->getDecisions().acceptTrade(targetPlayer, offer)) {
+        // Transfer money and property
+        currentPlayer->payMoney(*game, amount, targetPlayer);
+        
+        // Move the property from the target player to the current player
+        targetPlayer->releaseProperty(receiveProperty);
+        currentPlayer->acquireProperty(receiveProperty);
+        
+        gameOutput() << "Trade completed successfully!" << endl;
+    } else {
+        gameOutput() << "Trade rejected." << endl;
+    }
+}
+// Handle property for money trade (currentPlayer gives property)
+else if (!giveIsMoney && receiveIsMoney) {
+    Property* giveProperty = game->getBoard().getPropertyByName(give);
+    int amount = stoi(receive);
     
-    // Set player properties
-    // Add money
-    while (player->getMoney() < money) {
-        player->receiveMoney(100);
+    if (!giveProperty) {
+        gameOutput() << "Error: Property " << give << " not found." << endl;
+        return;
     }
     
-    // Set position
-    player->teleport(position);
+    // Check ownership
+    if (giveProperty->getOwner() != currentPlayer) {
+        gameOutput() << "Error: You don't own " << give << "." << endl;
+        return;
+    }
     
-    // Set Tims Cups
-    for (int j = 0; j < timsCups; j++) {
-        player->addTimsCup();
+    // Check if target player has enough money
+    if (!targetPlayer->canPayAmount(amount)) {
+        gameOutput() << "Error: " << targetPlayerName << " doesn't have enough money for this trade." << endl;
+        return;
     }
     
-    // Set Tims Line status
-    if (position == 10 && inTimsLineStatus == 1) {
-        player->enterTimsLine();
-        for (int j = 0; j < turnsInTimsLine; j++) {
-            player->incrementTurnsInTimsLine();
+    // Check for improvements on the property or in the monopoly
+    AcademicBuilding* giveAcademic = asAcademicBuilding(giveProperty);
+    if (giveAcademic) {
+        if (giveAcademic->getImprovements() > 0) {
+            gameOutput() << "Error: Cannot trade " << give << " as it has improvements. Sell improvements first." << endl;
+            return;
+        }
+        
+        if (currentPlayer->ownsMonopoly(giveAcademic)) {
+            for (const auto& prop : currentPlayer->getProperties()) {
+                AcademicBuilding* academic = asAcademicBuilding(prop);
+                if (academic && academic->getBlockId() == giveAcademic->getBlockId() && academic->getImprovements() > 0) {
+                    gameOutput() << "Error: Cannot trade " << give << " as a property in its monopoly has improvements." << endl;
+                    return;
+                }
+            }
         }
     }
     
-    players.push_back(player);
+    // Offer the trade to the target player
+    string offer = "your $" + to_string(amount) + " for " + currentPlayer->getName() + "'s " + give;
+    gameOutput() << "Trade offered to " << targetPlayerName << ": " << offer << endl;
+    gameOutput() << targetPlayerName << ", do you accept this trade? (accept/reject): ";
+    
+    if (game->getDecisions().acceptTrade(targetPlayer, offer)) {
+        // Transfer money and property
+        targetPlayer->payMoney(*game, amount, currentPlayer);
+        
+        // Move the property from the current player to the target player
+        currentPlayer->releaseProperty(giveProperty);
+        targetPlayer->acquireProperty(giveProperty);
+        
+        gameOutput() << "Trade completed successfully!" << endl;
+    } else {
+        gameOutput() << "Trade rejected." << endl;
+    }
+}
 }
 
-// Load property information
-std::string line;
-while (std::getline(file, line)) {
-    std::stringstream ss(line);
-    std::string propertyName, ownerName;
-    int improvements;
+void CommandInterpreter::executeImprove(const vector<string>& args) {
+if (args.size() != 2) {
+    gameOutput() << "Error: Invalid improve command. Use: improve <property> buy/sell" << endl;
+    return;
+}
+
+string propertyName = args[0];
+string action = args[1];
+
+// Find the property
+Property* property = game->getBoard().getPropertyByName(propertyName);
+if (!property) {
+    gameOutput() << "Error: Property " << propertyName << " not found." << endl;
+    return;
+}
+
+// Check if it's an academic building
+AcademicBuilding* academic = asAcademicBuilding(property);
+if (!academic) {
+    gameOutput() << "Error: You can only improve academic buildings." << endl;
+    return;
+}
+
+// Check if the current player owns the property
+Player* currentPlayer = game->getCurrentPlayer();
+if (academic->getOwner() != currentPlayer) {
+    gameOutput() << "Error: You don't own " << propertyName << "." << endl;
+    return;
+}
+
+// Check if player owns the monopoly
+if (!currentPlayer->ownsMonopoly(academic)) {
+    gameOutput() << "Error: You must own all properties in the " << academic->getMonopolyBlock() << " monopoly to make improvements." << endl;
+    return;
+}
+
+// Execute the appropriate action
+if (action == "buy") {
+    // Check if maximum improvements already
+    if (academic->getImprovements() >= 5) {
+        gameOutput() << "Error: " << propertyName << " already has the maximum number of improvements." << endl;
+        return;
+    }
     
-    ss >> propertyName >> ownerName >> improvements;
+    // Check if player has enough money
+    int improvementCost = academic->getImprovementCost();
+    if (!currentPlayer->canPayAmount(improvementCost)) {
+        gameOutput() << "Error: You don't have enough money to buy an improvement. Cost: $" << improvementCost << endl;
+        return;
+    }
     
-    Property* property = board.getPropertyByName(propertyName);
-    if (!property) {
-        std::cerr << "Error: Property " << propertyName << " not found." << std::endl;
-        continue;
+    // Buy the improvement
+    if (currentPlayer->buyImprovement(academic)) {
+        gameOutput() << "Successfully bought an improvement for " << propertyName << "." << endl;
+    } else {
+        gameOutput() << "Failed to buy improvement for " << propertyName << "." << endl;
+    }
+} 
+else if (action == "sell") {
+    // Check if there are improvements to sell
+    if (academic->getImprovements() <= 0) {
+        gameOutput() << "Error: " << propertyName << " has no improvements to sell." << endl;
+        return;
     }
     
-    if (ownerName != "BANK") {
-        // Find the player with this name
-        Player* owner = nullptr;
-        for (auto player : players) {
-            if (player->getName() == ownerName) {
-                owner = player;
-                break;
-            }
-        }
-        
-        if (!owner) {
-            std::cerr << "Error: Player " << ownerName << " not found." << std::endl;
-            continue;
-        }
-        
-        // Set the owner
-        property->setOwner(owner);
-        const_cast<std::vector<Property*>&>(owner->getProperties()).push_back(property);
-        // Add to player's properties
-        // owner->buyProperty(property);
-        
-        // Handle mortgages and improvements
-        if (improvements == -1) {
-            property->mortgage();
-        } else if (improvements > 0) {
-            // Only academic buildings can have improvements
-            AcademicBuilding* academic = dynamic_cast<AcademicBuilding*>(property);
-            if (academic) {
-                for (int i = 0; i < improvements; ++i) {
-                    academic->addImprovement();
-                }
-            }
-        }
+    // Sell the improvement
+    if (currentPlayer->sellImprovement(academic)) {
+        gameOutput() << "Successfully sold an improvement from " << propertyName << "." << endl;
+    } else {
+        gameOutput() << "Failed to sell improvement from " << propertyName << "." << endl;
     }
+} 
+else {
+    gameOutput() << "Error: Invalid action '" << action << "'. Use 'buy' or 'sell'." << endl;
 }
-
-currentPlayerIndex = 0; // Start with the first player
-file.close();
 }
 
-void Game::removeBankruptPlayer(Player* bankruptPlayer) {
-// Find the player in the list and remove them
-auto it = std::find(players.begin(), players.end(), bankruptPlayer);
-if (it != players.end()) {
-  // If the current player is going bankrupt, move to the next player first
-  if (*it == getCurrentPlayer()) {
-    nextPlayer();
-  }
-  
-  // Remove the player from the list
-  players.erase(it);
-  
-  // Delete the player object if it was dynamically allocated
-  delete bankruptPlayer;
-  
-  // Check if the game should end
-  if (players.size() <= 1) {
-    endGame();
-  }
+void CommandInterpreter::executeMortgage(const vector<string>& args) {
+if (args.size() != 1) {
+    gameOutput() << "Error: Invalid mortgage command. Use: mortgage <property>" << endl;
+    return;
 }
+
+string propertyName = args[0];
+
+// Find the property
+Property* property = game->getBoard().getPropertyByName(propertyName);
+if (!property) {
+    gameOutput() << "Error: Property " << propertyName << " not found." << endl;
+    return;
 }
 
-void Game::saveGame(std::string filename) {
-std::ofstream file(filename);
-if (!file.is_open()) {
-    std::cerr << "Error opening file: " << filename << std::endl;
+// Check if the current player owns the property
+Player* currentPlayer = game->getCurrentPlayer();
+if (property->getOwner() != currentPlayer) {
+    gameOutput() << "Error: You don't own " << propertyName << "." << endl;
     return;
 }
 
-// Save number of players
-file << players.size() << std::endl;
+// Check if the property is already mortgaged
+if (property->isMortgaged()) {
+    gameOutput() << "Error: " << propertyName << " is already mortgaged." << endl;
+    return;
+}
 
-// Save player information
-for (auto player : players) {
-    file << player->getName() << " "
-         << player->getPiece() << " "
-         << player->getTimsCups() << " "
-         << player->getMoney() << " "
-         << player->getPosition();
+// Check if there are improvements on the property for Academic Buildings
+AcademicBuilding* academic = asAcademicBuilding(property);
+if (academic && academic->getImprovements() > 0) {
+    gameOutput() << "Error: You must sell all improvements on " << propertyName << " before mortgaging it." << endl;
+    return;
+}
 
-    // Handle DC Tims Line
-    if (player->getPosition() == 10) {
-        if (player->isInTimsLine()) {
-            file << " 1 " << player->getTurnsInTimsLine();
-        } else {
-            file << " 0";
+// Check if any property in the monopoly has improvements (for Academic Buildings)
+if (academic && currentPlayer->ownsMonopoly(academic)) {
+    for (const auto& prop : currentPlayer->getProperties()) {
+        AcademicBuilding* other = asAcademicBuilding(prop);
+        if (other && other->getBlockId() == academic->getBlockId() && other->getImprovements() > 0) {
+            gameOutput() << "Error: You must sell all improvements in the " << academic->getMonopolyBlock() 
+                 << " monopoly before mortgaging any property in it." << endl;
+            return;
         }
     }
+}
 
-    file << std::endl;
+// Mortgage the property
+if (currentPlayer->mortgageProperty(property)) {
+    gameOutput() << "Successfully mortgaged " << propertyName << " for $" << property->getPurchaseCost() / 2 << "." << endl;
+} else {
+    gameOutput() << "Failed to mortgage " << propertyName << "." << endl;
+}
 }
 
-// Save property information
-// We need to go through all properties in board order
-for (int i = 0; i < 40; i++) {
-  Tile* tile = board.getTile(i);
-  if (!tile) continue;
+void CommandInterpreter::executeUnmortgage(const vector<string>& args) {
+if (args.size() != 1) {
+    gameOutput() << "Error: Invalid unmortgage command. Use: unmortgage <property>" << endl;
+    return;
+}
 
-  Property* property = dynamic_cast<Property*>(tile);
-  if (!property) continue; // Skip non-property tiles
+string propertyName = args[0];
 
-  // Write property name
-  file << property->getName() << " ";
+// Find the property
+Property* property = game->getBoard().getPropertyByName(propertyName);
+if (!property) {
+    gameOutput() << "Error: Property " << propertyName << " not found." << endl;
+    return;
+}
 
-  // Write owner
-  if (property->getOwner()) {
-      file << property->getOwner()->getName() << " ";
-  } else {
-      file << "BANK" << " ";
-  }
+// Check if the current player owns the property
+Player* currentPlayer = game->getCurrentPlayer();
+if (property->getOwner() != currentPlayer) {
+    gameOutput() << "Error: You don't own " << propertyName << "." << endl;
+    return;
+}
 
-  // Write improvements or mortgage status
-  if (property->isMortgaged()) {
-      file << "-1";
-  } else {
-      // Check if it's an academic building with improvements
-      AcademicBuilding* academic = dynamic_cast<AcademicBuilding*>(property);
-      if (academic) {
-          file << academic->getImprovements();
-      } else {
-          file << "0"; // Residences and Gyms always have 0 improvements
-      }
-  }
+// Check if the property is mortgaged
+if (!property->isMortgaged()) {
+    gameOutput() << "Error: " << propertyName << " is not mortgaged." << endl;
+    return;
+}
 
-  file << std::endl;
+// Calculate unmortgage cost (mortgage value + 10% interest)
+int mortgageValue = property->getPurchaseCost() / 2;
+int interest = property->getPurchaseCost() / 10; // 10% of original cost
+int totalCost = mortgageValue + interest;
+
+// Check if player has enough money
+if (!currentPlayer->canPayAmount(totalCost)) {
+    gameOutput() << "Error: You don't have enough money to unmortgage this property. Cost: $" << totalCost << endl;
+    return;
+}
+
+// Unmortgage the property
+if (currentPlayer->unmortgageProperty(*game, property)) {
+    gameOutput() << "Successfully unmortgaged " << propertyName << " for $" << totalCost << "." << endl;
+} else {
+    gameOutput() << "Failed to unmortgage " << propertyName << "." << endl;
+}
+}
+
+void CommandInterpreter::executeBankrupt() {
+Player* currentPlayer = game->getCurrentPlayer();
+
+// Check if player is actually in a position where they must declare bankruptcy
+if (currentPlayer->getNetWorth() > 0) {
+    gameOutput() << "You can only declare bankruptcy when you cannot pay a debt." << endl;
+    return;
+}
+
+gameOutput() << "Are you sure you want to declare bankruptcy? (y/n): ";
+DecisionProvider& decisions = game->getDecisions();
+
+if (decisions.confirmBankruptcy(currentPlayer)) {
+    // Ask if bankruptcy is to another player or to the bank
+    gameOutput() << "Declare bankruptcy to another player? Enter player name or 'bank': ";
+    string creditorName = decisions.chooseCreditor(currentPlayer);
+    
+    if (creditorName == "bank" || creditorName == "Bank" || creditorName == "BANK") {
+        // Bankruptcy to the bank
+        gameOutput() << currentPlayer->getName() << " has declared bankruptcy to the Bank!" << endl;
+        
+        // Return all properties to the bank and auction them
+        auto playerProperties = currentPlayer->getProperties(); // a copy, releasing edits the original
+        for (auto property : playerProperties) {
+            currentPlayer->releaseProperty(property);
+            
+            // The bank auctions it unmortgaged and unimproved
+            property->reset();
+            
+            gameOutput() << "Auctioning " << property->getName() << "..." << endl;
+            game->auctionProperty(property);
+        }
+        
+        // Destroy any Roll Up the Rim cups
+        // (This would be handled by the Player class's bankruptcy method)
+        
+        // Remove player from the game
+        currentPlayer->declaredBankruptcy();
+        
+        gameOutput() << currentPlayer->getName() << " is out of the game." << endl;
+    } else {
+        // Bankruptcy to another player
+        Player* creditor = game->getPlayerByName(creditorName);
+        
+        if (!creditor) {
+            gameOutput() << "Player " << creditorName << " not found. Bankruptcy canceled." << endl;
+            return;
+        }
+        
+        gameOutput() << currentPlayer->getName() << " has declared bankruptcy to " << creditor->getName() << "!" << endl;
+        
+        // Transfer all assets to the creditor
+        currentPlayer->declaredBankruptcy(creditor);
+        
+        gameOutput() << "All assets have been transferred to " << creditor->getName() << "." << endl;
+        gameOutput() << currentPlayer->getName() << " is out of the game." << endl;
+    }
+    
+    // Take the player out of the turn order; this also ends the game if one player is left
+    game->removeBankruptPlayer(currentPlayer);
+} else {
+    gameOutput() << "Bankruptcy canceled." << endl;
 }
-
-file.close();
 }
-
-void Game::nextPlayer() {
-// Move to the next player
-currentPlayerIndex = (currentPlayerIndex + 1) % players.size();
-std::cout << "Next player: " << players[currentPlayerIndex]->getName() << std::endl;
+void CommandInterpreter::executeAssets() {
+  Player* currentPlayer = game->getCurrentPlayer();
+  gameOutput() << currentPlayer->getAssets() << endl;
 }
 
-void Game::processCommand(std::string command) {
-commandInterpreter->parseCommand(command);
+void CommandInterpreter::executeAll() {
+  for (const auto& player : game->getPlayers()) {
+    gameOutput() << "--- " << player->getName() << " ---" << endl;
+    gameOutput() << player->getAssets() << endl;
+    gameOutput() << endl;
+  }
 }
 
-void Game::endGame() {
-// End the game and declare the winner
-if (players.size() == 1) {
-    cout << "Game over! Winner: " << players[0]->getName() << "!" << endl;
-} else {
-    cout << "Game ended with multiple players still active." << endl;
-}
+void CommandInterpreter::executeStats() {
+  game->getMetrics().report(output(), game->getBoard());
 }
 
-void Game::auctionProperty(Property* property) {
-// Implement auction logic
-std::cout << "Starting auction for " << property->getName() << std::endl;
-int highestBid = 0;
-Player* highestBidder = nullptr;
-std::string input;
-while (true) {
-    std::cout << "Current highest bid: " << highestBid << " by ";
-    if (highestBidder) {
-        std::cout << highestBidder->getName();
-    } else {
-        std::cout << "none";
-    }
-    std::cout << std::endl;
-    std::cout << "Enter your bid or 'pass': ";
-    std::getline(std::cin, input);
-    
-    if (input == "pass") {
-        break;
-    }
-    
-    int bid = std::stoi(input);
-    if (bid > highestBid) {
-        highestBid = bid;
-        highestBidder = getCurrentPlayer();
+void CommandInterpreter::executeSave(const vector<string>& args) {
+  if (args.size() != 1) {
+    gameOutput() << "Error: Invalid save command. Use: save <filename>" << endl;
+    return;
+  }
+  
+  string filename = args[0];
+  
+  try {
+    // A .snap file gets the binary snapshot, anything else the text format
+    if (filename.size() > 5 && filename.compare(filename.size() - 5, 5, ".snap") == 0) {
+      game->saveSnapshot(filename);
     } else {
-        std::cout << "Bid must be higher than the current highest bid." << std::endl;
+      game->saveGame(filename);
     }
-    nextPlayer();
+    gameOutput() << "Game saved to " << filename << endl;
+  } catch (const exception& e) {
+    gameOutput() << "Error saving game: " << e.what() << endl;
+  }
 }
 
-if (highestBidder) {
-    std::cout << highestBidder->getName() << " won the auction for " << highestBid << "!" << std::endl;
-    highestBidder->payMoney(highestBid, nullptr);
-    property->setOwner(highestBidder);
-} else {
-    std::cout << "No one won the auction." << std::endl;
-}
-}
+//----------------------------------
+// HEADLESS ENGINE IMPLEMENTATION
+//----------------------------------
 
-int Game::getNumPlayers() const {
-return players.size();
+HeadlessEngine::HeadlessEngine() : game{false}, seated{game} {
+  game.setDecisionProvider(&defaultDecisions);
 }
 
-bool Game::canGiveMoreCups() {
-if(maxTimsCups > currentTimsCupsInGame){
-  return true;
+void HeadlessEngine::setDecisionProvider(DecisionProvider* provider) {
+  game.setDecisionProvider(provider ? provider : &defaultDecisions);
 }
-return false;
+
+void HeadlessEngine::setSeatDecisions(vector<DecisionProvider*> providers) {
+  seated.assign(std::move(providers));
+  game.setDecisionProvider(&seated);
 }
 
-Player* Game::getCurrentPlayer() const {
-  if(players.empty() || currentPlayerIndex >= players.size()){ 
-    return nullptr; 
+GameResult HeadlessEngine::play(int numPlayers, int maxTurns) {
+  if (numPlayers < 2 || numPlayers > 6) {
+    throw invalid_argument("Headless games need between 2 and 6 players");
   }
-  return players[currentPlayerIndex];
-}
 
-// Added getters needed by CommandInterpreter
-Dice& Game::getDice() {
-  return dice;
-}
+  static const char pieces[] = {'G','B','D','P','S','$','L','T'};
+  vector<pair<string, char>> roster;
+  for (int i = 0; i < numPlayers; ++i) {
+    roster.emplace_back("Player" + to_string(i + 1), pieces[i]);
+  }
 
-Board& Game::getBoard() {
-  return board;
+  utilities::SinkSwap silence{quiet};
+  game.initialize(roster);
+  return game.runHeadless(maxTurns);
 }
 
-Player* Game::getPlayerByName(const string& name) {
-  for (auto player : players) {
-    if (player->getName() == name) {
-      return player;
-    }
-  }
-  return nullptr;
+GameResult HeadlessEngine::play(const GameState& from, int maxTurns) {
+  utilities::SinkSwap silence{quiet};
+  game.loadState(from);
+  return game.runHeadless(maxTurns);
 }
 
-void Game::mainLoop() {
-bool gameOver = false;
+//----------------------------------
+// COMMAND LOG IMPLEMENTATION
+//----------------------------------
 
-while (!gameOver) {
-  // Check for game ending conditions
-  if (players.size() <= 1) {
-    gameOver = true;
-    continue;
+namespace {
+  std::string readWholeFile(const std::string& filename, bool& found) {
+    std::ifstream in(filename, std::ios::binary);
+    found = in.is_open();
+    return found ? std::string{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()} : std::string{};
   }
-  // Display board state
-  board.display();
-  
-  // Display current player's assets
-  Player* currentPlayer = getCurrentPlayer();
-  std::cout << "Current player: " << currentPlayer->getName() << std::endl;
-  std::cout << "Assets: " << currentPlayer->getAssets() << std::endl;
-  
-  // Process commands for the current player
-  std::string command;
-  std::cout << "> ";
-  std::getline(std::cin, command);
-  
-  if (command == "quit") {
-    gameOver = true;
-  } else {
-    processCommand(command);
+
+  std::uint64_t snapshotChecksum(const std::string& snapshot) {
+    SnapshotHeader header;
+    std::memcpy(&header, snapshot.data(), sizeof(header));
+    return header.checksum;
   }
-  
-  
 }
 
-endGame();
+std::uint64_t stateHash(const Game& game) {
+  std::string snapshot;
+  game.writeSnapshot(snapshot);
+  return snapshotChecksum(snapshot);
 }
 
-//-----------------------------------
-// COMMAND INTERPRETER IMPLEMENTATIONS
-//-----------------------------------
+// Records this log's answers by wrapping whatever provider the game uses now.
+// Logs nest, so they have to be detached in the reverse order they were attached.
+void CommandLog::attach(Game& game) {
+  this->game = &game;
+  recorder.setInner(&game.getDecisions());
+  game.setDecisionProvider(&recorder);
+  game.addCommandLog(this);
+}
 
-CommandInterpreter::CommandInterpreter(Game* game, bool testingMode) 
-  : game(game), testingMode(testingMode) {}
+void CommandLog::detach() {
+  if (!game) return;
+  game->removeCommandLog(this);
+  if (&game->getDecisions() == &recorder) {
+    game->setDecisionProvider(recorder.getInner());
+  }
+  game = nullptr;
+}
 
-void CommandInterpreter::parseCommand(const string& command) {
-  // Tokenize the command
-  vector<string> tokens = tokenizeCommand(command);
-  
-  if (tokens.empty()) {
-    return;
+void CommandLog::begin() {
+  drawsBefore = game->getRng().drawCount();
+  recorder.take();
+}
+
+void CommandLog::writeRecord(std::ostream& out, const std::string& command) {
+  std::vector<std::string> answers = recorder.take();
+  out << game->getRng().drawCount() - drawsBefore << ' '
+      << game->getDice().getDie1() << ' ' << game->getDice().getDie2() << ' ' << answers.size();
+  for (const std::string& answer : answers) {
+    out << ' ' << answer;
   }
-  
-  string action = tokens[0];
-  vector<string> args(tokens.begin() + 1, tokens.end());
-  
-  // Execute appropriate command
-  if (action == "roll") {
-    executeRoll(args);
-  } else if (action == "next") {
-    executeNext();
-  } else if (action == "trade") {
-    executeTrade(args);
-  } else if (action == "improve") {
-    executeImprove(args);
-  } else if (action == "mortgage") {
-    executeMortgage(args);
-  } else if (action == "unmortgage") {
-    executeUnmortgage(args);
-  } else if (action == "bankrupt") {
-    executeBankrupt();
-  } else if (action == "assets") {
-    executeAssets();
-  } else if (action == "all") {
-    executeAll();
-  } else if (action == "save") {
-    executeSave(args);
-  } else {
-    cout << "Invalid command: " << action << endl;
+  out << ' ' << command << '\n';
+}
+
+bool CommandLog::replayRecord(Game& game, ScriptedDecisions& scripted, const std::string& line) {
+  std::istringstream record{line};
+  std::uint64_t draws;
+  int die1, die2;
+  std::size_t count;
+  record >> draws >> die1 >> die2 >> count;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::string answer;
+    record >> answer;
+    scripted.push(answer);
   }
-}
+  std::string command;
+  std::getline(record >> std::ws, command);
 
-vector<string> CommandInterpreter::tokenizeCommand(const string& command) {
-  vector<string> tokens;
-  istringstream iss(command);
-  string token;
-  
-  while (iss >> token) {
-    tokens.push_back(token);
+  std::uint64_t before = game.getRng().drawCount();
+  try {
+    game.processCommand(command);
+  } catch (const out_of_range&) {
+    // The command asked for more answers than were recorded
+    return false;
   }
-  
-  return tokens;
+  // Dice are not part of a snapshot, so they are only compared when this command rolled
+  bool rolled = draws != 0;
+  bool same = game.getRng().drawCount() - before == draws && scripted.remaining() == 0 &&
+              (!rolled || (game.getDice().getDie1() == die1 && game.getDice().getDie2() == die2));
+  scripted.clear(); // answers the command did not ask for
+  return same;
 }
 
-void CommandInterpreter::executeRoll(const vector<string>& args) {
-if (testingMode && args.size() == 2) {
-    // In testing mode, we can specify the dice values
-    try {
-        int die1 = stoi(args[0]);
-        int die2 = stoi(args[1]);
-        
-        if (die1 < 0 || die2 < 0) {
-            throw out_of_range("Dice values must be non-negative");
-        }
-        
-        Dice& dice = game->getDice();
-        dice.setTestDice(die1, die2);
-        cout << "Rolling " << die1 << " and " << die2 << " (testing mode)" << endl;
-    } catch (const exception& e) {
-        cout << "Error: " << e.what() << endl;
-        return;
-    }
-} else if (!args.empty()) {
-    cout << "Error: Invalid arguments for roll command" << endl;
-    return;
-} else {
-    // Normal roll
-    Dice& dice = game->getDice();
-    dice.roll();
-    cout << "Rolled " << dice.getTotal() << endl;
-}
+//----------------------------------
+// JOURNAL IMPLEMENTATION
+//----------------------------------
 
-// Get the current player and move them
-Player* currentPlayer = game->getCurrentPlayer();
-if (!currentPlayer) {
-    cout << "Error: No current player" << endl;
-    return;
-}
+Journal::Journal(std::string path, int checkpointInterval)
+  : path{std::move(path)}, checkpointInterval{checkpointInterval} {}
 
-Dice& dice = game->getDice();
-int steps = dice.getTotal();
+Journal::~Journal() {
+  detach();
+}
 
-// Check if player is in Tims Line
-if (currentPlayer->isInTimsLine()) {
-    if (dice.isDoubles()) {
-        cout << currentPlayer->getName() << " rolled doubles and is leaving Tims Line!" << endl;
-        currentPlayer->leaveTimsLine();
-    } else {
-        cout << currentPlayer->getName() << " is in Tims Line and did not roll doubles." << endl;
-        
-        // PROMPT THE PLAYER TO USE A CUP OR PAY REGARDLESS OF TURNS
-        bool hasRimCup = currentPlayer->getTimsCups() > 0;
-        int turnsInTimsLine = currentPlayer->getTurnsInTimsLine();
-        
-        // If it's their third turn or later, they MUST leave
-        bool mustLeave = (turnsInTimsLine >= 2);
-        
-        if (hasRimCup) {
-            cout << "Do you want to use a Roll Up the Rim cup to leave? (y/n): ";
-            char useCup;
-            cin >> useCup;
-            
-            if (useCup == 'y' || useCup == 'Y') {
-                currentPlayer->useTimsCup();
-                cout << "Used a Roll Up the Rim cup to leave Tims Line!" << endl;
-                currentPlayer->leaveTimsLine();
-            } else if (mustLeave) {
-                // On third turn, must pay if they don't use a cup
-                cout << "This is your third turn in Tims Line. You must pay $50 to leave." << endl;
-                if (currentPlayer->payMoney(50, nullptr)) {
-                    cout << "Paid $50 to leave Tims Line." << endl;
-                    currentPlayer->leaveTimsLine();
-                } else {
-                    cout << "Cannot pay $50. You must trade, mortgage, or declare bankruptcy." << endl;
-                    return;
-                }
-            } else {
-                // Not third turn, give option to pay or stay
-                cout << "Do you want to pay $50 to leave? (y/n): ";
-                char pay;
-                cin >> pay;
-                
-                if (pay == 'y' || pay == 'Y') {
-                    if (currentPlayer->payMoney(50, nullptr)) {
-                        cout << "Paid $50 to leave Tims Line." << endl;
-                        currentPlayer->leaveTimsLine();
-                    } else {
-                        cout << "Cannot pay $50. You must trade, mortgage, or declare bankruptcy." << endl;
-                        return;
-                    }
-                } else {
-                    // Stay in Tims Line
-                    currentPlayer->incrementTurnsInTimsLine();
-                    cout << "Staying in Tims Line. Turn ended." << endl;
-                    game->nextPlayer();
-                    return;
-                }
-            }
-        } else {
-            // No Rim Cup, check if must pay or can choose
-            if (mustLeave) {
-                cout << "This is your third turn in Tims Line. You must pay $50 to leave." << endl;
-                if (currentPlayer->payMoney(50, nullptr)) {
-                    cout << "Paid $50 to leave Tims Line." << endl;
-                    currentPlayer->leaveTimsLine();
-                } else {
-                    cout << "Cannot pay $50. You must trade, mortgage, or declare bankruptcy." << endl;
-                    return;
-                }
-            } else {
-                // Not third turn, give option to pay or stay
-                cout << "Do you want to pay $50 to leave? (y/n): ";
-                char pay;
-                cin >> pay;
-                
-                if (pay == 'y' || pay == 'Y') {
-                    if (currentPlayer->payMoney(50, nullptr)) {
-                        cout << "Paid $50 to leave Tims Line." << endl;
-                        currentPlayer->leaveTimsLine();
-                    } else {
-                        cout << "Cannot pay $50. You must trade, mortgage, or declare bankruptcy." << endl;
-                        return;
-                    }
-                } else {
-                    // Stay in Tims Line
-                    currentPlayer->incrementTurnsInTimsLine();
-                    cout << "Staying in Tims Line. Turn ended." << endl;
-                    game->nextPlayer();
-                    return;
-                }
-            }
-        }
+bool Journal::recover(Game& game) {
+  bool found = false;
+  std::string snapshot = readWholeFile(path + ".snap", found);
+  if (!found) {
+    return false;
+  }
+  game.readSnapshot(snapshot.data(), snapshot.size());
+
+  std::string log = readWholeFile(path, found);
+  std::istringstream lines{log.substr(0, log.rfind('\n') + 1)}; // drop a torn last record
+  std::string line, tag;
+  std::uint64_t base = 0;
+  if (!std::getline(lines, line) || !(std::istringstream{line} >> tag >> std::hex >> base) ||
+      tag != "snapshot" || base != snapshotChecksum(snapshot)) {
+    // The journal predates this checkpoint, so everything in it is already in the snapshot
+    return true;
+  }
+
+  // Replay each record silently, feeding back the recorded answers
+  NullSink quiet;
+  utilities::SinkSwap silence{quiet};
+  ScriptedDecisions scripted;
+  DecisionProvider* previous = &game.getDecisions();
+  game.setDecisionProvider(&scripted);
+  int replayed = 0;
+  while (std::getline(lines, line)) {
+    ++replayed;
+    if (!replayRecord(game, scripted, line)) {
+      game.setDecisionProvider(previous);
+      throw runtime_error("journal record " + std::to_string(replayed) + " replayed differently");
     }
+  }
+  game.setDecisionProvider(previous);
+  return true;
 }
 
-// Move the player - this happens if they're not in Tims Line or just left it
-Board& board = game->getBoard();
-int oldPosition = currentPlayer->getPosition();
-board.movePlayer(currentPlayer, steps);
-int newPosition = currentPlayer->getPosition();
+void Journal::start(Game& game) {
+  attach(game);
+  checkpoint();
+}
 
-cout << currentPlayer->getName() << " moved from " << oldPosition 
-     << " to " << newPosition << endl;
+void Journal::commit(const std::string& command) {
+  // Saving writes files but changes nothing in the game, so it is not replayed
+  if (command.empty() || command.compare(0, 4, "save") == 0) {
+    return;
+  }
+  writeRecord(file, command);
+  file.flush();
 
-// Get the tile and handle landing
-Tile* tile = board.getTile(newPosition);
-if (tile) {
-    tile->landedOn(currentPlayer);
+  if (++sinceCheckpoint >= checkpointInterval) {
+    checkpoint();
+  }
 }
 
-// If we rolled doubles, player gets another turn unless they're in Tims Line
-if (dice.isDoubles() && !currentPlayer->isInTimsLine()) {
-    cout << "Rolled doubles! " << currentPlayer->getName() << " gets another turn." << endl;
-} else {
-    game->nextPlayer();
-}
+// Writes the snapshot beside the journal, swaps it in with a rename, then restarts
+// the journal. A crash between the two leaves a journal naming an older snapshot,
+// which recovery recognises and skips.
+void Journal::checkpoint() {
+  std::string snapshot;
+  game->writeSnapshot(snapshot);
+  {
+    std::ofstream out(path + ".snap.tmp", std::ios::binary);
+    if (!out.write(snapshot.data(), snapshot.size())) {
+      throw runtime_error("cannot write " + path + ".snap.tmp");
+    }
+  }
+  if (std::rename((path + ".snap.tmp").c_str(), (path + ".snap").c_str()) != 0) {
+    throw runtime_error("cannot replace " + path + ".snap");
+  }
+
+  file.close();
+  file.open(path, std::ios::trunc);
+  if (!file.is_open()) {
+    throw runtime_error("cannot open journal " + path);
+  }
+  file << "snapshot " << std::hex << snapshotChecksum(snapshot) << std::dec << '\n';
+  file.flush();
+  sinceCheckpoint = 0;
 }
 
+//----------------------------------
+// RECORD AND REPLAY IMPLEMENTATION
+//----------------------------------
 
-void CommandInterpreter::executeNext() {
-  game->nextPlayer();
-  cout << "Turn passed to " << game->getCurrentPlayer()->getName() << endl;
+namespace {
+  const char* const recordingTag = "watopoly-recording";
+  constexpr int recordingVersion = 1;
+  const char* const hexDigits = "0123456789abcdef";
 }
 
-void CommandInterpreter::executeTrade(const vector<string>& args) {
-if (args.size() != 3) {
-    cout << "Error: Invalid trade command. Use: trade <name> <give> <receive>" << endl;
-    return;
+SessionRecorder::SessionRecorder(const std::string& path) : file{path} {
+  if (!file.is_open()) {
+    throw runtime_error("cannot open recording " + path);
+  }
 }
 
-string targetPlayerName = args[0];
-string give = args[1];
-string receive = args[2];
+SessionRecorder::~SessionRecorder() {
+  finish();
+}
 
-// Find the target player
-Player* currentPlayer = game->getCurrentPlayer();
-Player* targetPlayer = game->getPlayerByName(targetPlayerName);
+void SessionRecorder::start(Game& game, std::uint64_t seed) {
+  std::string snapshot;
+  game.writeSnapshot(snapshot);
+  file << recordingTag << ' ' << recordingVersion << '\n'
+       << "seed " << seed << '\n'
+       << "testing " << game.isTesting() << '\n'
+       << "state ";
+  for (unsigned char byte : snapshot) {
+    file << hexDigits[byte >> 4] << hexDigits[byte & 0x0f];
+  }
+  file << '\n';
+  attach(game);
+}
 
-if (!targetPlayer) {
-    cout << "Error: Player " << targetPlayerName << " not found." << endl;
+void SessionRecorder::commit(const std::string& command) {
+  if (command.empty() || command.compare(0, 4, "save") == 0) {
     return;
+  }
+  writeRecord(file, command);
 }
 
-// Check if both are money (not allowed)
-bool giveIsMoney = utilities::isNumeric(give);
-bool receiveIsMoney = utilities::isNumeric(receive);
-
-if (giveIsMoney && receiveIsMoney) {
-    cout << "Error: Cannot trade money for money." << endl;
-    return;
+void SessionRecorder::finish() {
+  if (!game) return;
+  file << "end " << std::hex << stateHash(*game) << std::dec << '\n';
+  file.flush();
+  detach();
 }
 
-// Handle property for property trade
-if (!giveIsMoney && !receiveIsMoney) {
-    // Find the properties
-    Property* giveProperty = game->getBoard().getPropertyByName(give);
-    Property* receiveProperty = game->getBoard().getPropertyByName(receive);
-    
-    if (!giveProperty || !receiveProperty) {
-        cout << "Error: One or both properties not found." << endl;
-        return;
+namespace {
+  // Opens a recording and reads the header lines up to the starting position
+  std::ifstream openRecording(const std::string& path, bool& testing, std::string& hex) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+      throw runtime_error("cannot open recording " + path);
     }
-    
-    // Check ownership
-    if (giveProperty->getOwner() != currentPlayer) {
-        cout << "Error: You don't own " << give << "." << endl;
-        return;
-    }
-    
-    if (receiveProperty->getOwner() != targetPlayer) {
-        cout << "Error: " << targetPlayerName << " doesn't own " << receive << "." << endl;
-        return;
-    }
-    
-    // Check for improvements on the property or in the monopoly
-    AcademicBuilding* giveAcademic = dynamic_cast<AcademicBuilding*>(giveProperty);
-    if (giveAcademic) {
-        // Check if property has improvements
-        if (giveAcademic->getImprovements() > 0) {
-            cout << "Error: Cannot trade " << give << " as it has improvements. Sell improvements first." << endl;
-            return;
-        }
-        
-        // Check if any property in the monopoly has improvements
-        if (currentPlayer->ownsMonopoly(giveAcademic->getMonopolyBlock())) {
-            for (const auto& prop : currentPlayer->getProperties()) {
-                AcademicBuilding* academic = dynamic_cast<AcademicBuilding*>(prop);
-                if (academic && academic->getMonopolyBlock() == giveAcademic->getMonopolyBlock() && academic->getImprovements() > 0) {
-                    cout << "Error: Cannot trade " << give << " as a property in its monopoly has improvements." << endl;
-                    return;
-                }
-            }
-        }
-    }
-    
-    // Same checks for receive property
-    AcademicBuilding* receiveAcademic = dynamic_cast<AcademicBuilding*>(receiveProperty);
-    if (receiveAcademic) {
-        if (receiveAcademic->getImprovements() > 0) {
-            cout << "Error: Cannot trade " << receive << " as it has improvements." << endl;
-            return;
-        }
-        
-        if (targetPlayer->ownsMonopoly(receiveAcademic->getMonopolyBlock())) {
-            for (const auto& prop : targetPlayer->getProperties()) {
-                AcademicBuilding* academic = dynamic_cast<AcademicBuilding*>(prop);
-                if (academic && academic->getMonopolyBlock() == receiveAcademic->getMonopolyBlock() && academic->getImprovements() > 0) {
-                    cout << "Error: Cannot trade " << receive << " as a property in its monopoly has improvements." << endl;
-                    return;
-                }
-            }
-        }
+    std::string tag;
+    int version = 0;
+    std::uint64_t seed = 0;
+    if (!(file >> tag >> version) || tag != recordingTag || version != recordingVersion) {
+      throw runtime_error(path + " is not a version " + std::to_string(recordingVersion) + " recording");
     }
-    
-    // Offer the trade to the target player
-    cout << "Trade offered to " << targetPlayerName << ": your " << receive << " for " << currentPlayer->getName() << "'s " << give << endl;
-    cout << targetPlayerName << ", do you accept this trade? (accept/reject): ";
-    
-    string response;
-    cin >> response;
-    
-    if (response == "accept") {
-        // Swap property ownership
-        auto& currentPlayerProps = const_cast<vector<Property*>&>(currentPlayer->getProperties());
-        auto& targetPlayerProps = const_cast<vector<Property*>&>(targetPlayer->getProperties());
-        
-        // Remove properties from their current owners
-        currentPlayerProps.erase(remove(currentPlayerProps.begin(), currentPlayerProps.end(), giveProperty), currentPlayerProps.end());
-        targetPlayerProps.erase(remove(targetPlayerProps.begin(), targetPlayerProps.end(), receiveProperty), targetPlayerProps.end());
-        
-        // Add properties to their new owners
-        currentPlayerProps.push_back(receiveProperty);
-        targetPlayerProps.push_back(giveProperty);
-        
-        // Update property ownership
-        giveProperty->setOwner(targetPlayer);
-        receiveProperty->setOwner(currentPlayer);
-        
-        cout << "Trade completed successfully!" << endl;
-    } else {
-        cout << "Trade rejected." << endl;
+    if (!(file >> tag >> seed) || tag != "seed" || !(file >> tag >> testing) || tag != "testing" ||
+        !(file >> tag >> hex) || tag != "state" || hex.size() % 2) {
+      throw runtime_error(path + " has no starting position");
     }
+    return file;
+  }
 }
-// Handle money for property trade (currentPlayer gives money)
-else if (giveIsMoney && !receiveIsMoney) {
-    int amount = stoi(give);
-    Property* receiveProperty = game->getBoard().getPropertyByName(receive);
-    
-    if (!receiveProperty) {
-        cout << "Error: Property " << receive << " not found." << endl;
-        return;
-    }
-    
-    // Check ownership
-    if (receiveProperty->getOwner() != targetPlayer) {
-        cout << "Error: " << targetPlayerName << " doesn't own " << receive << "." << endl;
-        return;
-    }
-    
-    // Check if current player has enough money
-    if (!currentPlayer->canPayAmount(amount)) {
-        cout << "Error: You don't have enough money for this trade." << endl;
-        return;
-    }
-    
-    // Check for improvements on the property or in the monopoly
-    AcademicBuilding* receiveAcademic = dynamic_cast<AcademicBuilding*>(receiveProperty);
-    if (receiveAcademic) {
-        if (receiveAcademic->getImprovements() > 0) {
-            cout << "Error: Cannot trade " << receive << " as it has improvements." << endl;
-            return;
-        }
-        
-        if (targetPlayer->ownsMonopoly(receiveAcademic->getMonopolyBlock())) {
-            for (const auto& prop : targetPlayer->getProperties()) {
-                AcademicBuilding* academic = dynamic_cast<AcademicBuilding*>(prop);
-                if (academic && academic->getMonopolyBlock() == receiveAcademic->getMonopolyBlock() && academic->getImprovements() > 0) {
-                    cout << "Error: Cannot trade " << receive << " as a property in its monopoly has improvements." << endl;
-                    return;
-                }
-            }
-        }
-    }
-    
-    // Offer the trade to the target player
-    cout << "Trade offered to " << targetPlayerName << ": your " << receive << " for $" << amount << endl;
-    cout << targetPlayerName << ", do you accept this trade? (accept/reject): ";
-    
-    string response;
-    cin >> response;
-    
-    if (response == "accept") {
-        // Transfer money and property
-        currentPlayer->payMoney(amount, targetPlayer);
-        
-        // Remove property from target player
-        auto& targetPlayerProps = const_cast<vector<Property*>&>(targetPlayer->getProperties());
-        targetPlayerProps.erase(remove(targetPlayerProps.begin(), targetPlayerProps.end(), receiveProperty), targetPlayerProps.end());
-        
-        // Add property to current player
-        auto& currentPlayerProps = const_cast<vector<Property*>&>(currentPlayer->getProperties());
-        currentPlayerProps.push_back(receiveProperty);
-        
-        // Update property ownership
-        receiveProperty->setOwner(currentPlayer);
-        
-        cout << "Trade completed successfully!" << endl;
-    } else {
-        cout << "Trade rejected." << endl;
-    }
+
+bool recordedInTestingMode(const std::string& path) {
+  bool testing = false;
+  std::string hex;
+  openRecording(path, testing, hex);
+  return testing;
 }
-// Handle property for money trade (currentPlayer gives property)
-else if (!giveIsMoney && receiveIsMoney) {
-    Property* giveProperty = game->getBoard().getPropertyByName(give);
-    int amount = stoi(receive);
-    
-    if (!giveProperty) {
-        cout << "Error: Property " << give << " not found." << endl;
-        return;
-    }
-    
-    // Check ownership
-    if (giveProperty->getOwner() != currentPlayer) {
-        cout << "Error: You don't own " << give << "." << endl;
-        return;
+
+ReplayReport replaySession(const std::string& path, Game& game) {
+  bool testing = false;
+  std::string line, hex;
+  std::ifstream file = openRecording(path, testing, hex);
+  std::string snapshot(hex.size() / 2, '\0');
+  for (std::size_t i = 0; i < snapshot.size(); ++i) {
+    snapshot[i] = static_cast<char>(std::stoi(hex.substr(2 * i, 2), nullptr, 16));
+  }
+  file.ignore(); // end of the state line
+
+  ReplayReport report;
+  NullSink quiet;
+  utilities::SinkSwap silence{quiet};
+  game.readSnapshot(snapshot.data(), snapshot.size());
+  ScriptedDecisions scripted;
+  DecisionProvider* previous = &game.getDecisions();
+  game.setDecisionProvider(&scripted);
+
+  auto started = std::chrono::steady_clock::now();
+  bool ended = false;
+  while (std::getline(file, line)) {
+    if (line.compare(0, 4, "end ") == 0) {
+      report.expectedHash = std::stoull(line.substr(4), nullptr, 16);
+      ended = true;
+      break;
     }
-    
-    // Check if target player has enough money
-    if (!targetPlayer->canPayAmount(amount)) {
-        cout << "Error: " << targetPlayerName << " doesn't have enough money for this trade." << endl;
-        return;
+    ++report.commands;
+    if (!CommandLog::replayRecord(game, scripted, line) && report.divergedAt == 0) {
+      report.divergedAt = report.commands;
     }
-    
-    // Check for improvements on the property or in the monopoly
-    AcademicBuilding* giveAcademic = dynamic_cast<AcademicBuilding*>(giveProperty);
-    if (giveAcademic) {
-        if (giveAcademic->getImprovements() > 0) {
-            cout << "Error: Cannot trade " << give << " as it has improvements. Sell improvements first." << endl;
-            return;
+  }
+  report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  game.setDecisionProvider(previous);
+  if (!ended) {
+    throw runtime_error(path + " ends without a final state");
+  }
+  report.actualHash = stateHash(game);
+  return report;
+}
+
+//----------------------------------
+// LANDING ANALYSIS IMPLEMENTATION
+//----------------------------------
+
+namespace {
+  // Four doubles per vector; GCC lowers this to whatever SIMD the target has
+  typedef double double4 __attribute__((vector_size(32)));
+}
+
+LandingAnalysis analyzeLandings(const Board& board, bool payToLeave) {
+  const int tiles = board.getTileCount();
+  int timsLine = -1;
+  for (int pos = 0; pos < tiles && timsLine < 0; ++pos) {
+    if (board.getTile(pos)->getKind() == TileKind::TimsLine) timsLine = pos;
+  }
+  if (timsLine < 0) {
+    throw runtime_error("the board has no Tims Line");
+  }
+
+  // States 0..tiles-1 rest on a tile, the next three wait in Tims Line
+  const int states = tiles + 3;
+  const int blocks = (states + 3) / 4;
+  std::vector<double4> step(states * blocks, double4{});     // column s: where a roll from s leaves the token
+  std::vector<double4> lands(states * blocks, double4{});    // column s: where a roll from s lands first
+  std::vector<double> extraRoll(states, 0.0);                // chance a roll from s earns another
+  auto at = [&](std::vector<double4>& m, int column, int row) -> double& {
+    return reinterpret_cast<double*>(&m[column * blocks])[row];
+  };
+
+  int slcTotal = 0;
+  for (auto [move, weight] : slcMovements()) slcTotal += weight;
+
+  for (int from = 0; from < states; ++from) {
+    int waited = from - tiles;
+    for (int die1 = 1; die1 <= 6; ++die1) {
+      for (int die2 = 1; die2 <= 6; ++die2) {
+        const double p = 1.0 / 36;
+        const bool doubles = die1 == die2;
+        int start = from;
+        if (waited >= 0) {
+          if (!doubles && waited < 2 && !payToLeave) {
+            at(step, from, tiles + waited + 1) += p; // stays in line another turn
+            continue;
+          }
+          start = timsLine;
         }
-        
-        if (currentPlayer->ownsMonopoly(giveAcademic->getMonopolyBlock())) {
-            for (const auto& prop : currentPlayer->getProperties()) {
-                AcademicBuilding* academic = dynamic_cast<AcademicBuilding*>(prop);
-                if (academic && academic->getMonopolyBlock() == giveAcademic->getMonopolyBlock() && academic->getImprovements() > 0) {
-                    cout << "Error: Cannot trade " << give << " as a property in its monopoly has improvements." << endl;
-                    return;
-                }
+
+        const int target = (start + die1 + die2) % tiles;
+        at(lands, from, target) += p;
+        switch (board.getTile(target)->getKind()) {
+          case TileKind::GoToTims:
+            at(step, from, tiles) += p;
+            break;
+          case TileKind::SLC:
+            for (auto [move, weight] : slcMovements()) {
+              const double q = p * weight / slcTotal;
+              const int to = move == 10 ? tiles : move == 0 ? 0 : ((target + move) % tiles + tiles) % tiles;
+              at(step, from, to) += q;
+              if (doubles && to != tiles) extraRoll[from] += q;
             }
+            break;
+          default:
+            at(step, from, target) += p;
+            if (doubles) extraRoll[from] += p;
+            break;
         }
+      }
     }
-    
-    // Offer the trade to the target player
-    cout << "Trade offered to " << targetPlayerName << ": your $" << amount << " for " << currentPlayer->getName() << "'s " << give << endl;
-    cout << targetPlayerName << ", do you accept this trade? (accept/reject): ";
-    
-    string response;
-    cin >> response;
-    
-    if (response == "accept") {
-        // Transfer money and property
-        targetPlayer->payMoney(amount, currentPlayer);
-        
-        // Remove property from current player
-        auto& currentPlayerProps = const_cast<vector<Property*>&>(currentPlayer->getProperties());
-        currentPlayerProps.erase(remove(currentPlayerProps.begin(), currentPlayerProps.end(), giveProperty), currentPlayerProps.end());
-        
-        // Add property to target player
-        auto& targetPlayerProps = const_cast<vector<Property*>&>(targetPlayer->getProperties());
-        targetPlayerProps.push_back(giveProperty);
-        
-        // Update property ownership
-        giveProperty->setOwner(targetPlayer);
-        
-        cout << "Trade completed successfully!" << endl;
-    } else {
-        cout << "Trade rejected." << endl;
+  }
+
+  // Power iteration: pi <- step * pi, accumulated one column at a time across
+  // whole vectors of rows, until the L1 change drops below 1e-13
+  std::vector<double4> pi(blocks, double4{}), next(blocks);
+  reinterpret_cast<double*>(pi.data())[0] = 1.0; // start on Collect OSAP
+  LandingAnalysis result{};
+  for (result.iterations = 1; result.iterations <= 100000; ++result.iterations) {
+    std::fill(next.begin(), next.end(), double4{});
+    const double* weights = reinterpret_cast<const double*>(pi.data());
+    for (int column = 0; column < states; ++column) {
+      const double4 w = double4{} + weights[column];
+      const double4* col = &step[column * blocks];
+      for (int b = 0; b < blocks; ++b) next[b] += w * col[b];
     }
-}
+    double4 change{};
+    for (int b = 0; b < blocks; ++b) {
+      double4 d = next[b] - pi[b];
+      change += d < 0 ? -d : d;
+    }
+    pi.swap(next);
+    if (change[0] + change[1] + change[2] + change[3] < 1e-13) break;
+  }
+
+  const double* stationary = reinterpret_cast<const double*>(pi.data());
+  result.resting.assign(stationary, stationary + tiles);
+  std::copy(stationary + tiles, stationary + states, result.inTimsLine);
+
+  std::vector<double4> landed(blocks, double4{});
+  double extra = 0;
+  for (int column = 0; column < states; ++column) {
+    const double4 w = double4{} + stationary[column];
+    for (int b = 0; b < blocks; ++b) landed[b] += w * lands[column * blocks + b];
+    extra += stationary[column] * extraRoll[column];
+  }
+  const double* landedOn = reinterpret_cast<const double*>(landed.data());
+  result.landing.assign(landedOn, landedOn + tiles);
+  result.rollsPerTurn = 1.0 / (1.0 - extra);
+  return result;
 }
 
-void CommandInterpreter::executeImprove(const vector<string>& args) {
-if (args.size() != 2) {
-    cout << "Error: Invalid improve command. Use: improve <property> buy/sell" << endl;
-    return;
+//----------------------------------
+// IMPROVEMENT RETURNS IMPLEMENTATION
+//----------------------------------
+
+std::vector<BlockReturn> improvementReturns(const Board& board, const LandingAnalysis& landings) {
+  constexpr int levels = 6;
+
+  // Lay every academic building out flat, block by block, so each level is one
+  // contiguous multiply of landing odds by tuition
+  std::vector<const AcademicBuilding*> buildings;
+  std::vector<std::pair<std::string, int>> blockEnds; // block name, one past its last building
+  for (const auto& [block, members] : board.getAcademicBlocks()) {
+    buildings.insert(buildings.end(), members.begin(), members.end());
+    blockEnds.emplace_back(block, static_cast<int>(buildings.size()));
+  }
+  const int count = static_cast<int>(buildings.size());
+  std::vector<double> perTurn(count);
+  std::vector<double> tuition(levels * count);
+  std::vector<double> rent(levels * count);
+  for (int i = 0; i < count; ++i) {
+    perTurn[i] = landings.landing[buildings[i]->getLocation()] * landings.rollsPerTurn;
+    for (int level = 0; level < levels; ++level) {
+      tuition[level * count + i] = buildings[i]->getTuitionAt(level);
+    }
+  }
+  for (int level = 0; level < levels; ++level) {
+    const double* t = &tuition[level * count];
+    double* r = &rent[level * count];
+    for (int i = 0; i < count; ++i) r[i] = perTurn[i] * t[i];
+  }
+
+  std::vector<BlockReturn> returns;
+  returns.reserve(blockEnds.size() * levels);
+  int first = 0;
+  for (const auto& [block, end] : blockEnds) {
+    double previousRent = 0;
+    for (int level = 0; level < levels; ++level) {
+      BlockReturn row{block, level, 0, 0, 0, 0, 0};
+      for (int i = first; i < end; ++i) {
+        row.cost += level == 0 ? buildings[i]->getPurchaseCost() : buildings[i]->getImprovementCost();
+        row.rentPerTurn += rent[level * count + i];
+      }
+      row.marginalRent = row.rentPerTurn - previousRent;
+      row.paybackTurns = row.marginalRent > 0 ? row.cost / row.marginalRent : std::numeric_limits<double>::infinity();
+      row.returnPerDollar = row.cost > 0 ? row.marginalRent / row.cost : 0;
+      previousRent = row.rentPerTurn;
+      returns.push_back(row);
+    }
+    first = end;
+  }
+  return returns;
 }
 
-string propertyName = args[0];
-string action = args[1];
+//----------------------------------
+// SIMULATION FARM IMPLEMENTATION
+//----------------------------------
 
-// Find the property
-Property* property = game->getBoard().getPropertyByName(propertyName);
-if (!property) {
-    cout << "Error: Property " << propertyName << " not found." << endl;
-    return;
+WorkStealingPool::WorkStealingPool(unsigned threads, std::uint64_t grain)
+  : ranges(threads ? threads : std::max(1u, std::thread::hardware_concurrency())), grain{std::max<std::uint64_t>(grain, 1)} {}
+
+// Pops the next slice off the front of this worker's own range
+bool WorkStealingPool::take(unsigned worker, std::uint64_t& begin, std::uint64_t& end) {
+  Range& own = ranges[worker];
+  std::lock_guard<std::mutex> hold{own.lock};
+  if (own.begin == own.end) return false;
+  begin = own.begin;
+  end = std::min(own.end, begin + grain);
+  own.begin = end;
+  return true;
 }
 
-// Check if it's an academic building
-AcademicBuilding* academic = dynamic_cast<AcademicBuilding*>(property);
-if (!academic) {
-    cout << "Error: You can only improve academic buildings." << endl;
-    return;
+// Moves the back half of the largest range left into this worker's empty one
+bool WorkStealingPool::steal(unsigned worker) {
+  for (;;) {
+    unsigned victim = worker;
+    std::uint64_t largest = 0;
+    for (unsigned i = 0; i < ranges.size(); ++i) {
+      std::lock_guard<std::mutex> hold{ranges[i].lock};
+      if (ranges[i].end - ranges[i].begin > largest) {
+        largest = ranges[i].end - ranges[i].begin;
+        victim = i;
+      }
+    }
+    if (largest == 0) return false;
+
+    std::uint64_t begin, end;
+    {
+      std::lock_guard<std::mutex> hold{ranges[victim].lock};
+      Range& from = ranges[victim];
+      if (from.begin == from.end) continue; // drained meanwhile, look again
+      std::uint64_t left = from.end - from.begin;
+      begin = left > grain ? from.end - left / 2 : from.begin;
+      end = from.end;
+      from.end = begin;
+    }
+    std::lock_guard<std::mutex> hold{ranges[worker].lock};
+    ranges[worker].begin = begin;
+    ranges[worker].end = end;
+    return true;
+  }
 }
 
-// Check if the current player owns the property
-Player* currentPlayer = game->getCurrentPlayer();
-if (academic->getOwner() != currentPlayer) {
-    cout << "Error: You don't own " << propertyName << "." << endl;
-    return;
+void WorkStealingPool::run(std::uint64_t count, const std::function<void(unsigned, std::uint64_t, std::uint64_t)>& task) {
+  unsigned workers = ranges.size();
+  for (unsigned i = 0; i < workers; ++i) {
+    ranges[i].begin = count * i / workers;
+    ranges[i].end = count * (i + 1) / workers;
+  }
+
+  std::mutex failure;
+  std::exception_ptr error;
+  auto work = [&](unsigned worker) {
+    try {
+      std::uint64_t begin, end;
+      while (take(worker, begin, end) || (steal(worker) && take(worker, begin, end))) {
+        task(worker, begin, end);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> hold{failure};
+      if (!error) error = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < workers; ++i) {
+    threads.emplace_back(work, i);
+  }
+  work(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) std::rethrow_exception(error);
 }
 
-// Check if player owns the monopoly
-if (!currentPlayer->ownsMonopoly(academic->getMonopolyBlock())) {
-    cout << "Error: You must own all properties in the " << academic->getMonopolyBlock() << " monopoly to make improvements." << endl;
-    return;
+void SimTotals::merge(const SimTotals& other) {
+  games += other.games;
+  finished += other.finished;
+  turns += other.turns;
+  if (seatWins.size() < other.seatWins.size()) {
+    seatWins.resize(other.seatWins.size());
+  }
+  for (size_t i = 0; i < other.seatWins.size(); ++i) {
+    seatWins[i] += other.seatWins[i];
+  }
+  for (const auto& [name, count] : other.strategyGames) strategyGames[name] += count;
+  for (const auto& [name, count] : other.strategyWins) strategyWins[name] += count;
 }
 
-// Execute the appropriate action
-if (action == "buy") {
-    // Check if maximum improvements already
-    if (academic->getImprovements() >= 5) {
-        cout << "Error: " << propertyName << " already has the maximum number of improvements." << endl;
-        return;
+SimTotals runSimulation(const SimJob& job) {
+  if (job.players < 2 || job.players > 6) {
+    throw invalid_argument("Simulated games need between 2 and 6 players");
+  }
+  if (job.strategies.empty()) {
+    throw invalid_argument("A simulation needs at least one strategy");
+  }
+  for (const auto& name : job.strategies) {
+    // Reject unknown names before any thread starts
+    if (!isStrategy(name)) throw invalid_argument("Unknown strategy " + name);
+  }
+
+  WorkStealingPool pool{job.threads, job.grain};
+  const size_t kinds = job.strategies.size();
+  struct Worker {
+    std::unique_ptr<HeadlessEngine> engine;
+    std::vector<std::unique_ptr<DecisionProvider>> strategies;
+    std::uint64_t games = 0, finished = 0, turns = 0;
+    std::vector<std::uint64_t> seatWins, kindGames, kindWins;
+  };
+  std::vector<Worker> workers(pool.size());
+
+  pool.run(job.games, [&](unsigned index, std::uint64_t begin, std::uint64_t end) {
+    Worker& worker = workers[index];
+    if (!worker.engine) {
+      // Built on the worker's own thread the first time it gets games
+      worker.engine = std::make_unique<HeadlessEngine>();
+      for (const auto& name : job.strategies) {
+        worker.strategies.push_back(makeStrategy(name, worker.engine->getGame()));
+      }
+      worker.seatWins.assign(job.players, 0);
+      worker.kindGames.assign(kinds, 0);
+      worker.kindWins.assign(kinds, 0);
     }
-    
-    // Check if player has enough money
-    int improvementCost = academic->getImprovementCost();
-    if (!currentPlayer->canPayAmount(improvementCost)) {
-        cout << "Error: You don't have enough money to buy an improvement. Cost: $" << improvementCost << endl;
-        return;
+
+    std::vector<DecisionProvider*> seats(job.players);
+    for (std::uint64_t g = begin; g < end; ++g) {
+      for (int s = 0; s < job.players; ++s) {
+        seats[s] = worker.strategies[(s + g) % kinds].get();
+        worker.kindGames[(s + g) % kinds]++;
+      }
+      worker.engine->setSeatDecisions(seats);
+      worker.engine->seed(job.firstSeed + g);
+      GameResult result = worker.engine->play(job.players, job.maxTurns);
+      if (result.winnerSeat >= 0) {
+        worker.seatWins[result.winnerSeat]++;
+        worker.kindWins[(result.winnerSeat + g) % kinds]++;
+      }
+      worker.turns += result.turns;
+      worker.finished += result.finished;
+      worker.games++;
     }
-    
-    // Buy the improvement
-    if (currentPlayer->buyImprovement(academic)) {
-        cout << "Successfully bought an improvement for " << propertyName << "." << endl;
-    } else {
-        cout << "Failed to buy improvement for " << propertyName << "." << endl;
+  });
+
+  SimTotals merged;
+  merged.seatWins.assign(job.players, 0);
+  for (const auto& worker : workers) {
+    SimTotals totals{worker.games, worker.finished, worker.turns, worker.seatWins, {}, {}};
+    for (size_t k = 0; k < worker.kindGames.size(); ++k) {
+      totals.strategyGames[job.strategies[k]] += worker.kindGames[k];
+      totals.strategyWins[job.strategies[k]] += worker.kindWins[k];
     }
-} 
-else if (action == "sell") {
-    // Check if there are improvements to sell
-    if (academic->getImprovements() <= 0) {
-        cout << "Error: " << propertyName << " has no improvements to sell." << endl;
+    merged.merge(totals);
+  }
+  return merged;
+}
+
+//----------------------------------
+// MONTE CARLO SEARCH IMPLEMENTATION
+//----------------------------------
+
+namespace {
+  std::uint64_t mixKey(std::uint64_t key, std::uint64_t value) {
+    key ^= value + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+    return key;
+  }
+
+  // What seat is deciding about, coarsely enough that later turns meet the same key
+  std::uint64_t decisionKey(int kind, int tile, int seat, int cash) {
+    return mixKey(mixKey(mixKey(kind, tile), seat), cash / 100);
+  }
+
+  // Choices come in mid-turn; rollouts start at the next seat still playing
+  void passTurn(GameState& state) {
+    for (int step = 1; step <= state.numSeats; ++step) {
+      int seat = (state.currentPlayer + step) % state.numSeats;
+      if (!(state.playerFlags[seat] & GameState::bankrupt)) {
+        state.currentPlayer = seat;
         return;
+      }
     }
-    
-    // Sell the improvement
-    if (currentPlayer->sellImprovement(academic)) {
-        cout << "Successfully sold an improvement from " << propertyName << "." << endl;
-    } else {
-        cout << "Failed to sell improvement from " << propertyName << "." << endl;
+  }
+
+  void leaveTimsLine(GameState& state, int seat) {
+    state.playerFlags[seat] &= ~GameState::inTimsLine;
+    state.turnsInTimsLine[seat] = 0;
+  }
+
+  // One side of a trade offer, "$amount" or a property name
+  struct TradeSide {
+    int tile = -1;
+    int cash = 0;
+  };
+
+  bool parseTradeSide(const Board& board, const std::string& text, TradeSide& side) {
+    if (text.size() > 1 && text[0] == '$' && utilities::isNumeric(text.substr(1))) {
+      side.cash = std::stoi(text.substr(1));
+      return side.cash >= 0;
     }
-} 
-else {
-    cout << "Error: Invalid action '" << action << "'. Use 'buy' or 'sell'." << endl;
-}
-}
+    Property* property = board.findProperty(text);
+    if (!property) return false;
+    side.tile = property->getLocation();
+    return true;
+  }
 
-void CommandInterpreter::executeMortgage(const vector<string>& args) {
-if (args.size() != 1) {
-    cout << "Error: Invalid mortgage command. Use: mortgage <property>" << endl;
-    return;
+  // 1 for a win, 0 for a loss, otherwise the seat's share of all net worth
+  double rolloutScore(const GameResult& result, int seat) {
+    if (result.finished) {
+      return result.winnerSeat == seat ? 1.0 : 0.0;
+    }
+    long long total = 0;
+    for (int worth : result.netWorths) total += worth;
+    return total > 0 ? static_cast<double>(result.netWorths[seat]) / total : 0.0;
+  }
 }
 
-string propertyName = args[0];
+MctsBot::MctsBot(const Game& game, MctsConfig config)
+  : Bot{100}, game{game}, config{config}, pool{config.threads, 1}, engines(pool.size()) {}
 
-// Find the property
-Property* property = game->getBoard().getPropertyByName(propertyName);
-if (!property) {
-    cout << "Error: Property " << propertyName << " not found." << endl;
-    return;
+void MctsBot::newGame() {
+  reuse.clear();
+  auctionKey = 0;
+  auctionLimit = 0;
 }
 
-// Check if the current player owns the property
-Player* currentPlayer = game->getCurrentPlayer();
-if (property->getOwner() != currentPlayer) {
-    cout << "Error: You don't own " << propertyName << "." << endl;
-    return;
+int MctsBot::mostVisited(const vector<Stats>& stats) {
+  int best = 0;
+  for (size_t i = 1; i < stats.size(); ++i) {
+    if (stats[i].visits > stats[best].visits ||
+        (stats[i].visits == stats[best].visits && stats[i].value > stats[best].value)) {
+      best = i;
+    }
+  }
+  return best;
 }
 
-// Check if the property is already mortgaged
-if (property->isMortgaged()) {
-    cout << "Error: " << propertyName << " is already mortgaged." << endl;
-    return;
-}
+vector<MctsBot::Stats> MctsBot::search(int seat, std::uint64_t decision, const vector<Action>& candidates) {
+  const int count = candidates.size();
+  GameState root;
+  game.saveState(root);
 
-// Check if there are improvements on the property for Academic Buildings
-AcademicBuilding* academic = dynamic_cast<AcademicBuilding*>(property);
-if (academic && academic->getImprovements() > 0) {
-    cout << "Error: You must sell all improvements on " << propertyName << " before mortgaging it." << endl;
-    return;
-}
+  vector<Stats> prior(count);
+  for (int i = 0; i < count; ++i) {
+    auto it = reuse.find(mixKey(decision, i + 1));
+    if (it != reuse.end()) {
+      prior[i] = {it->second.visits * config.reuseWeight, it->second.value * config.reuseWeight};
+    }
+  }
 
-// Check if any property in the monopoly has improvements (for Academic Buildings)
-if (academic && currentPlayer->ownsMonopoly(academic->getMonopolyBlock())) {
-    for (const auto& prop : currentPlayer->getProperties()) {
-        AcademicBuilding* other = dynamic_cast<AcademicBuilding*>(prop);
-        if (other && other->getMonopolyBlock() == academic->getMonopolyBlock() && other->getImprovements() > 0) {
-            cout << "Error: You must sell all improvements in the " << academic->getMonopolyBlock() 
-                 << " monopoly before mortgaging any property in it." << endl;
-            return;
+  const unsigned workers = pool.size();
+  const std::uint64_t base = mixKey(mixKey(mixKey(root.rng[0], root.rng[1]), root.rng[2] ^ root.rng[3]), decision);
+  const auto start = std::chrono::steady_clock::now();
+  vector<vector<Stats>> fresh(workers, vector<Stats>(count));
+
+  pool.run(workers, [&](unsigned, std::uint64_t begin, std::uint64_t end) {
+    for (std::uint64_t worker = begin; worker < end; ++worker) {
+      if (!engines[worker]) {
+        engines[worker] = std::make_unique<HeadlessEngine>();
+      }
+      vector<Stats>& mine = fresh[worker];
+      const int budget = config.rollouts * (worker + 1) / workers - config.rollouts * worker / workers;
+
+      for (int n = 0; n < budget; ++n) {
+        if (config.milliseconds > 0 && n % 16 == 0) {
+          std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - start;
+          if (spent.count() > config.milliseconds) break;
+        }
+
+        // UCB1 over this thread's own visits plus the carried-over ones
+        double visits = 0;
+        for (int i = 0; i < count; ++i) visits += prior[i].visits + mine[i].visits;
+        int pick = -1;
+        double bestScore = 0;
+        for (int i = 0; i < count; ++i) {
+          double v = prior[i].visits + mine[i].visits;
+          double score = v == 0 ? std::numeric_limits<double>::infinity()
+                                : (prior[i].value + mine[i].value) / v + config.exploration * std::sqrt(std::log(visits) / v);
+          if (pick < 0 || score > bestScore) {
+            pick = i;
+            bestScore = score;
+          }
         }
+
+        GameState state = root;
+        candidates[pick](state);
+        passTurn(state);
+        Rng{mixKey(base, (worker << 32) + n)}.saveState(state.rng);
+        GameResult result = engines[worker]->play(state, config.horizon);
+        mine[pick].visits += 1;
+        mine[pick].value += rolloutScore(result, seat);
+      }
     }
+  });
+
+  vector<Stats> total = prior;
+  for (const auto& mine : fresh) {
+    for (int i = 0; i < count; ++i) {
+      total[i].visits += mine[i].visits;
+      total[i].value += mine[i].value;
+      rollouts += mine[i].visits;
+    }
+  }
+  for (int i = 0; i < count; ++i) {
+    reuse[mixKey(decision, i + 1)] = total[i];
+  }
+  return total;
 }
 
-// Mortgage the property
-if (currentPlayer->mortgageProperty(property)) {
-    cout << "Successfully mortgaged " << propertyName << " for $" << property->getPurchaseCost() / 2 << "." << endl;
-} else {
-    cout << "Failed to mortgage " << propertyName << "." << endl;
-}
-}
+bool MctsBot::buyProperty(Player* player, Property* property) {
+  int seat = game.getSeat(player);
+  int cost = property->getPurchaseCost();
+  if (seat < 0 || !player->canPayAmount(cost)) return false;
 
-void CommandInterpreter::executeUnmortgage(const vector<string>& args) {
-if (args.size() != 1) {
-    cout << "Error: Invalid unmortgage command. Use: unmortgage <property>" << endl;
-    return;
+  int tile = property->getLocation();
+  vector<Action> candidates{
+    [=](GameState& state) { state.owner[tile] = seat; state.cash[seat] -= cost; },
+    [](GameState&) {},
+  };
+  return mostVisited(search(seat, decisionKey(1, tile, seat, player->getMoney()), candidates)) == 0;
 }
 
-string propertyName = args[0];
+bool MctsBot::useTimsCup(Player* player) {
+  int seat = game.getSeat(player);
+  if (seat < 0) return true;
 
-// Find the property
-Property* property = game->getBoard().getPropertyByName(propertyName);
-if (!property) {
-    cout << "Error: Property " << propertyName << " not found." << endl;
-    return;
+  vector<Action> candidates{
+    [=](GameState& state) { state.timsCups[seat]--; leaveTimsLine(state, seat); },
+    [](GameState&) {},
+  };
+  return mostVisited(search(seat, decisionKey(2, player->getPosition(), seat, player->getMoney()), candidates)) == 0;
 }
 
-// Check if the current player owns the property
-Player* currentPlayer = game->getCurrentPlayer();
-if (property->getOwner() != currentPlayer) {
-    cout << "Error: You don't own " << propertyName << "." << endl;
-    return;
-}
+bool MctsBot::payToLeaveTims(Player* player) {
+  int seat = game.getSeat(player);
+  if (seat < 0 || !player->canPayAmount(50)) return false;
 
-// Check if the property is mortgaged
-if (!property->isMortgaged()) {
-    cout << "Error: " << propertyName << " is not mortgaged." << endl;
-    return;
-}
+  vector<Action> candidates{
+    [=](GameState& state) { state.cash[seat] -= 50; leaveTimsLine(state, seat); },
+    [](GameState&) {},
+  };
+  return mostVisited(search(seat, decisionKey(3, player->getPosition(), seat, player->getMoney()), candidates)) == 0;
+}
+
+// Offers read "your <asset> for $<amount>" or "your <asset> for <proposer>'s <property>",
+// made by the player whose turn it is. Accepting is searched against rejecting by
+// making the swap on the state copy; an offer in any other form is rejected.
+bool MctsBot::acceptTrade(Player* target, const string& offer) {
+  int seat = game.getSeat(target);
+  const Player* proposer = game.getCurrentPlayer();
+  int from = proposer ? game.getSeat(proposer) : -1;
+  const std::string prefix = "your ";
+  const std::string separator = " for ";
+  std::size_t split = offer.find(separator);
+  if (seat < 0 || from < 0 || seat == from || offer.rfind(prefix, 0) != 0 || split == std::string::npos) {
+    return Bot::acceptTrade(target, offer);
+  }
 
-// Calculate unmortgage cost (mortgage value + 10% interest)
-int mortgageValue = property->getPurchaseCost() / 2;
-int interest = property->getPurchaseCost() / 10; // 10% of original cost
-int totalCost = mortgageValue + interest;
+  std::string wanted = offer.substr(split + separator.size());
+  const std::string owner = proposer->getName() + "'s ";
+  if (wanted.rfind(owner, 0) == 0) {
+    wanted = wanted.substr(owner.size());
+  } else if (wanted.empty() || wanted[0] != '$') {
+    return Bot::acceptTrade(target, offer);
+  }
+  TradeSide give, take; // what the target gives up and what it gets
+  const Board& board = target->getBoard();
+  if (!parseTradeSide(board, offer.substr(prefix.size(), split - prefix.size()), give) ||
+      !parseTradeSide(board, wanted, take) || !target->canPayAmount(give.cash)) {
+    return Bot::acceptTrade(target, offer);
+  }
 
-// Check if player has enough money
-if (!currentPlayer->canPayAmount(totalCost)) {
-    cout << "Error: You don't have enough money to unmortgage this property. Cost: $" << totalCost << endl;
-    return;
-}
+  vector<Action> candidates{
+    [=](GameState& state) {
+      if (give.tile >= 0) state.owner[give.tile] = from;
+      if (take.tile >= 0) state.owner[take.tile] = seat;
+      state.cash[seat] += take.cash - give.cash;
+      state.cash[from] += give.cash - take.cash;
+    },
+    [](GameState&) {},
+  };
+  int tiles = (give.tile + 1) * (maxTiles + 1) + take.tile + 1;
+  return mostVisited(search(seat, decisionKey(6, tiles, seat, target->getMoney()), candidates)) == 0;
+}
+
+// One search per auction finds the highest price still worth more than letting
+// the property go; the bids themselves then climb to it in $10 steps
+int MctsBot::bid(Player* bidder, Property* property, int highestBid) {
+  int seat = game.getSeat(bidder);
+  if (seat < 0) return 0;
+
+  int tile = property->getLocation();
+  std::uint64_t key = mixKey(mixKey(game.getRng().drawCount(), tile), seat);
+  if (key != auctionKey) {
+    int cost = property->getPurchaseCost();
+    vector<int> prices{cost / 4, cost / 2, cost * 3 / 4, cost, cost * 5 / 4};
+    vector<Action> candidates{[](GameState&) {}};
+    for (int price : prices) {
+      candidates.push_back([=](GameState& state) { state.owner[tile] = seat; state.cash[seat] -= price; });
+    }
+    vector<Stats> stats = search(seat, decisionKey(4, tile, seat, bidder->getMoney()), candidates);
+
+    auto mean = [](const Stats& s) { return s.visits > 0 ? s.value / s.visits : 0.0; };
+    auctionKey = key;
+    auctionLimit = 0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+      if (stats[i + 1].visits > 0 && mean(stats[i + 1]) >= mean(stats[0])) {
+        auctionLimit = prices[i];
+      }
+    }
+  }
 
-// Unmortgage the property
-if (currentPlayer->unmortgageProperty(property)) {
-    cout << "Successfully unmortgaged " << propertyName << " for $" << totalCost << "." << endl;
-} else {
-    cout << "Failed to unmortgage " << propertyName << "." << endl;
+  int next = highestBid + 10;
+  return next <= auctionLimit && affords(bidder, next) ? next : 0;
 }
+
+AcademicBuilding* MctsBot::chooseImprovement(Player* player) {
+  int seat = game.getSeat(player);
+  if (seat < 0) return nullptr;
+
+  vector<AcademicBuilding*> buildings{nullptr};
+  vector<Action> candidates{[](GameState&) {}};
+  for (Property* property : player->getProperties()) {
+    AcademicBuilding* academic = asAcademicBuilding(property);
+    if (!academic || academic->isMortgaged() || academic->getImprovements() >= 5 ||
+        !affords(player, academic->getImprovementCost()) || !player->ownsMonopoly(academic)) {
+      continue;
+    }
+    int tile = academic->getLocation();
+    int cost = academic->getImprovementCost();
+    buildings.push_back(academic);
+    candidates.push_back([=](GameState& state) { state.tileFlags[tile]++; state.cash[seat] -= cost; });
+  }
+  if (buildings.size() == 1) return nullptr;
+
+  std::uint64_t key = decisionKey(5, buildings[1]->getBlockId(), seat, player->getMoney());
+  return buildings[mostVisited(search(seat, key, candidates))];
 }
 
-void CommandInterpreter::executeBankrupt() {
-Player* currentPlayer = game->getCurrentPlayer();
+//----------------------------------
+// TOURNAMENT IMPLEMENTATION
+//----------------------------------
 
-// Check if player is actually in a position where they must declare bankruptcy
-if (currentPlayer->getNetWorth() > 0) {
-    cout << "You can only declare bankruptcy when you cannot pay a debt." << endl;
-    return;
+namespace {
+  using Table = std::vector<int>; // strategy indexes in seat order before rotation
+
+  // Every way to seat size of count strategies, in lexicographic order
+  void addCombinations(std::vector<Table>& tables, int count, int size) {
+    Table table(size);
+    for (int i = 0; i < size; ++i) table[i] = i;
+    for (;;) {
+      tables.push_back(table);
+      int i = size - 1;
+      while (i >= 0 && table[i] == count - size + i) --i;
+      if (i < 0) return;
+      ++table[i];
+      for (int j = i + 1; j < size; ++j) table[j] = table[j - 1] + 1;
+    }
+  }
+
+  // Head-to-head results, [a * count + b] holding a's side against b
+  struct HeadToHead {
+    int count;
+    std::vector<double> won;      // draws count half
+    std::vector<double> played;
+    std::vector<std::uint64_t> games;
+    std::vector<std::uint64_t> wins;
+
+    explicit HeadToHead(int count)
+      : count{count}, won(count * count), played(count * count), games(count), wins(count) {}
+  };
+
+  // Bradley-Terry strengths by minorization-maximization. Every strategy also
+  // draws one virtual game against a strength-1 reference, which keeps a
+  // strategy that never won finite and pins the scale.
+  std::vector<double> fitStrengths(const HeadToHead& h) {
+    const int n = h.count;
+    std::vector<double> strength(n, 1.0), next(n);
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+      double change = 0;
+      for (int i = 0; i < n; ++i) {
+        double won = 0.5;
+        double weight = 1 / (strength[i] + 1);
+        for (int j = 0; j < n; ++j) {
+          if (j == i || h.played[i * n + j] == 0) continue;
+          won += h.won[i * n + j];
+          weight += h.played[i * n + j] / (strength[i] + strength[j]);
+        }
+        next[i] = won / weight;
+        change = std::max(change, std::abs(next[i] - strength[i]) / strength[i]);
+      }
+      strength.swap(next);
+      if (change < 1e-10) break;
+    }
+    return strength;
+  }
+
+  std::vector<Rating> rate(const TournamentConfig& config, const HeadToHead& h) {
+    const int n = h.count;
+    const double eloPerLog = 400 / std::log(10.0);
+    std::vector<double> strength = fitStrengths(h);
+
+    double mean = 0;
+    for (double s : strength) mean += std::log(s) / n;
+
+    std::vector<Rating> ratings;
+    for (int i = 0; i < n; ++i) {
+      // Curvature of the log-likelihood in log-strength gives the standard error
+      double information = strength[i] / ((strength[i] + 1) * (strength[i] + 1));
+      double won = 0, played = 0;
+      for (int j = 0; j < n; ++j) {
+        if (j == i) continue;
+        double pair = strength[i] + strength[j];
+        information += h.played[i * n + j] * strength[i] * strength[j] / (pair * pair);
+        won += h.won[i * n + j];
+        played += h.played[i * n + j];
+      }
+      double rating = 1500 + eloPerLog * (std::log(strength[i]) - mean);
+      double margin = 1.96 * eloPerLog / std::sqrt(information);
+      ratings.push_back({config.strategies[i], rating, rating - margin, rating + margin,
+                         h.games[i], h.wins[i], played > 0 ? won / played : 0});
+    }
+    std::stable_sort(ratings.begin(), ratings.end(),
+                     [](const Rating& a, const Rating& b) { return a.rating > b.rating; });
+    return ratings;
+  }
 }
 
-cout << "Are you sure you want to declare bankruptcy? (y/n): ";
-char response;
-cin >> response;
+std::vector<Rating> runTournament(const TournamentConfig& config) {
+  const int count = config.strategies.size();
+  if (count < 2) {
+    throw invalid_argument("A tournament needs at least two strategies");
+  }
+  for (const auto& name : config.strategies) {
+    if (!isStrategy(name)) throw invalid_argument("Unknown strategy " + name);
+  }
+  if (config.repeats < 1 || (config.swiss && config.rounds < 1)) {
+    throw invalid_argument("A tournament needs at least one round and one game per table");
+  }
+  // A table never seats a strategy twice, so it is no larger than the field
+  std::vector<int> sizes;
+  for (int size : config.playerCounts) {
+    if (size < 2 || size > 6) throw invalid_argument("Tables seat between 2 and 6 players");
+    if (size <= count) sizes.push_back(size);
+  }
+  if (sizes.empty()) {
+    throw invalid_argument("Every table size is larger than the number of strategies");
+  }
 
-if (response == 'y' || response == 'Y') {
-    // Ask if bankruptcy is to another player or to the bank
-    cout << "Declare bankruptcy to another player? Enter player name or 'bank': ";
-    string creditorName;
-    cin >> creditorName;
-    
-    if (creditorName == "bank" || creditorName == "Bank" || creditorName == "BANK") {
-        // Bankruptcy to the bank
-        cout << currentPlayer->getName() << " has declared bankruptcy to the Bank!" << endl;
-        
-        // Return all properties to the bank and auction them
-        vector<Property*> playerProperties = currentPlayer->getProperties();
-        for (auto property : playerProperties) {
-            property->setOwner(nullptr);
-            
-            // Unmortgage the property before auctioning
-            if (property->isMortgaged()) {
-                property->unmortgage();
-            }
-            
-            cout << "Auctioning " << property->getName() << "..." << endl;
-            game->auctionProperty(property);
+  struct Worker {
+    std::unique_ptr<HeadlessEngine> engine;
+    std::vector<std::unique_ptr<DecisionProvider>> strategies; // built on first use
+  };
+  struct Played {
+    std::vector<int> strategy;     // by seat
+    std::vector<long long> rank;   // higher is better
+    int winnerSeat;
+  };
+
+  WorkStealingPool pool{config.threads, 1};
+  std::vector<Worker> workers(pool.size());
+  HeadToHead results{count};
+  std::uint64_t gameNumber = 0;
+
+  // Plays every seat rotation of every table, in parallel, then records the results in game order
+  auto play = [&](const std::vector<Table>& tables) {
+    std::vector<std::pair<int, int>> schedule; // table, rotation
+    for (size_t t = 0; t < tables.size(); ++t) {
+      for (int r = 0; r < static_cast<int>(tables[t].size()) * config.repeats; ++r) {
+        schedule.emplace_back(t, r);
+      }
+    }
+    std::vector<Played> played(schedule.size());
+
+    pool.run(schedule.size(), [&](unsigned index, std::uint64_t begin, std::uint64_t end) {
+      Worker& worker = workers[index];
+      if (!worker.engine) {
+        worker.engine = std::make_unique<HeadlessEngine>();
+        worker.strategies.resize(count);
+      }
+      for (std::uint64_t g = begin; g < end; ++g) {
+        const Table& table = tables[schedule[g].first];
+        const int size = table.size();
+        Played& game = played[g];
+        std::vector<DecisionProvider*> seats(size);
+        for (int s = 0; s < size; ++s) {
+          int strategy = table[(s + schedule[g].second) % size];
+          if (!worker.strategies[strategy]) {
+            worker.strategies[strategy] = makeStrategy(config.strategies[strategy], worker.engine->getGame());
+          }
+          seats[s] = worker.strategies[strategy].get();
+          game.strategy.push_back(strategy);
         }
-        
-        // Destroy any Roll Up the Rim cups
-        // (This would be handled by the Player class's bankruptcy method)
-        
-        // Remove player from the game
-        currentPlayer->declaredBankruptcy();
-        
-        cout << currentPlayer->getName() << " is out of the game." << endl;
-    } else {
-        // Bankruptcy to another player
-        Player* creditor = game->getPlayerByName(creditorName);
-        
-        if (!creditor) {
-            cout << "Player " << creditorName << " not found. Bankruptcy canceled." << endl;
-            return;
+        worker.engine->setSeatDecisions(seats);
+        worker.engine->seed(config.seed + gameNumber + g);
+        GameResult result = worker.engine->play(size, config.maxTurns);
+        game.winnerSeat = result.winnerSeat;
+        for (int s = 0; s < size; ++s) {
+          game.rank.push_back(s == result.winnerSeat ? std::numeric_limits<long long>::max() : result.netWorths[s]);
         }
-        
-        cout << currentPlayer->getName() << " has declared bankruptcy to " << creditor->getName() << "!" << endl;
-        
-        // Transfer all assets to the creditor
-        currentPlayer->declaredBankruptcy(creditor);
-        
-        cout << "All assets have been transferred to " << creditor->getName() << "." << endl;
-        cout << currentPlayer->getName() << " is out of the game." << endl;
+      }
+    });
+
+    const int n = count;
+    for (const Played& game : played) {
+      const int size = game.strategy.size();
+      for (int s = 0; s < size; ++s) {
+        results.games[game.strategy[s]]++;
+        for (int u = s + 1; u < size; ++u) {
+          int a = game.strategy[s], b = game.strategy[u];
+          double aWon = game.rank[s] > game.rank[u] ? 1 : game.rank[s] < game.rank[u] ? 0 : 0.5;
+          results.won[a * n + b] += aWon;
+          results.won[b * n + a] += 1 - aWon;
+          results.played[a * n + b] += 1;
+          results.played[b * n + a] += 1;
+        }
+      }
+      if (game.winnerSeat >= 0) results.wins[game.strategy[game.winnerSeat]]++;
     }
-    
-    // Check if the game has ended (only one player left)
-    if (game->getNumPlayers() <= 1) {
-        game->endGame();
-    } else {
-        game->nextPlayer();
+    gameNumber += schedule.size();
+  };
+
+  if (!config.swiss) {
+    std::vector<Table> tables;
+    for (int size : sizes) addCombinations(tables, count, size);
+    play(tables);
+    return rate(config, results);
+  }
+
+  // Swiss: each round seats neighbours in the current standings together at
+  // full tables of that round's size. Strategies left over at the bottom of the
+  // standings, fewer than one table, sit the round out.
+  std::vector<int> standings(count);
+  for (int i = 0; i < count; ++i) standings[i] = i;
+  for (int round = 0; round < config.rounds; ++round) {
+    const int size = sizes[round % sizes.size()];
+    std::vector<Table> tables;
+    for (int first = 0; first + size <= count; first += size) {
+      tables.emplace_back(standings.begin() + first, standings.begin() + first + size);
     }
-} else {
-    cout << "Bankruptcy canceled." << endl;
+    play(tables);
+
+    std::vector<double> strength = fitStrengths(results);
+    std::stable_sort(standings.begin(), standings.end(),
+                     [&](int a, int b) { return strength[a] > strength[b]; });
+  }
+  return rate(config, results);
 }
+
+//----------------------------------
+// METRICS IMPLEMENTATION
+//----------------------------------
+
+std::uint64_t LatencyHistogram::quantileNs(double q) const {
+  if (count == 0) return 0;
+  std::uint64_t rank = static_cast<std::uint64_t>(q * (count - 1)) + 1;
+  std::uint64_t seen = 0;
+  for (int b = 0; b <= numBuckets; ++b) {
+    seen += buckets[b];
+    if (seen >= rank) {
+      if (b == 0) return 0;
+      if (b == numBuckets) return maxNs; // [2^63, 2^64) has no upper bound to shift to
+      return std::min(maxNs, (std::uint64_t{1} << b) - 1);
+    }
+  }
+  return maxNs;
 }
-void CommandInterpreter::executeAssets() {
-  Player* currentPlayer = game->getCurrentPlayer();
-  cout << currentPlayer->getAssets() << endl;
+
+namespace {
+  const char* const verbNames[] = {"roll", "next", "trade", "improve", "mortgage", "unmortgage",
+                                   "bankrupt", "assets", "all", "save", "stats", "invalid"};
+  static_assert(std::size(verbNames) == Metrics::numVerbs);
+
+  void reportTimes(std::ostream& out, const char* name, std::uint64_t count, const LatencyHistogram& time) {
+    char line[128];
+    std::snprintf(line, sizeof(line), "%-12s %8llu %10.1f %10.1f %10.1f %10.1f\n", name,
+                  static_cast<unsigned long long>(count), time.meanNs() / 1000, time.quantileNs(0.5) / 1000.0,
+                  time.quantileNs(0.99) / 1000.0, time.getMaxNs() / 1000.0);
+    out << line;
+  }
 }
 
-void CommandInterpreter::executeAll() {
-  for (const auto& player : game->getPlayers()) {
-    cout << "--- " << player->getName() << " ---" << endl;
-    cout << player->getAssets() << endl;
-    cout << endl;
+Metrics::Verb Metrics::verbOf(const std::string& action) {
+  for (int verb = 0; verb < Invalid; ++verb) {
+    if (action == verbNames[verb]) return static_cast<Verb>(verb);
   }
+  return Invalid;
 }
 
-void CommandInterpreter::executeSave(const vector<string>& args) {
-  if (args.size() != 1) {
-    cout << "Error: Invalid save command. Use: save <filename>" << endl;
-    return;
+const char* Metrics::verbName(Verb verb) {
+  return verbNames[verb];
+}
+
+void Metrics::report(std::ostream& out, const Board& board) const {
+  out << "Command         count    mean us     p50 us     p99 us     max us" << std::endl;
+  for (int verb = 0; verb < numVerbs; ++verb) {
+    if (commands[verb]) reportTimes(out, verbNames[verb], commands[verb], commandTime[verb]);
   }
-  
-  string filename = args[0];
-  
-  try {
-    game->saveGame(filename);
-    cout << "Game saved to " << filename << endl;
-  } catch (const exception& e) {
-    cout << "Error saving game: " << e.what() << endl;
+  if (displayTime.getCount()) reportTimes(out, "(display)", displayTime.getCount(), displayTime);
+  if (saveTime.getCount()) reportTimes(out, "(save)", saveTime.getCount(), saveTime);
+  if (loadTime.getCount()) reportTimes(out, "(load)", loadTime.getCount(), loadTime);
+
+  out << "Rent paid:";
+  bool anyRent = false;
+  for (int position = 0; position < maxTiles && position < board.getTileCount(); ++position) {
+    if (!rentPayments[position]) continue;
+    out << ' ' << board.getTile(position)->getName() << " $" << rentPaid[position] << " (" << rentPayments[position] << "x)";
+    anyRent = true;
   }
-}
\ No newline at end of file
+  out << (anyRent ? "" : " none") << std::endl;
+  out << "Auctions: " << auctions << ", bankruptcies: " << bankruptcies
+      << ", Tims Line entries: " << timsLineEntries << std::endl;
+}
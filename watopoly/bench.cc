@@ -0,0 +1,202 @@
+import <iostream>;
+import <fstream>;
+import <sstream>;
+import <string>;
+import <vector>;
+import <map>;
+import <memory>;
+import <chrono>;
+import <algorithm>;
+import <functional>;
+import <cstdio>;
+import <cstdint>;
+import watopoly;
+
+using namespace std;
+
+// Engine microbenchmarks.
+// Times each hot path on its own and writes name,ns_per_op,ops_per_sec,iterations
+// rows to a CSV file. Given a baseline CSV from an earlier run, it also reports
+// the change per benchmark and exits with 1 when any got slower than the tolerance.
+
+namespace {
+    volatile long long consumed = 0; // keeps results alive past the optimizer
+
+    struct Result {
+        string name;
+        double nsPerOp;
+        long long iterations;
+    };
+
+    // Runs op in batches sized to take about 50 ms, five times, and keeps the median
+    Result measure(const string& name, const function<void()>& op) {
+        using clock = chrono::steady_clock;
+        long long batch = 1;
+        for (;;) {
+            auto start = clock::now();
+            for (long long i = 0; i < batch; ++i) op();
+            chrono::duration<double> spent = clock::now() - start;
+            if (spent.count() > 0.05 || batch >= (1LL << 30)) break;
+            batch *= 2;
+        }
+
+        vector<double> trials;
+        for (int trial = 0; trial < 5; ++trial) {
+            auto start = clock::now();
+            for (long long i = 0; i < batch; ++i) op();
+            chrono::duration<double, nano> spent = clock::now() - start;
+            trials.push_back(spent.count() / batch);
+        }
+        sort(trials.begin(), trials.end());
+        return {name, trials[2], batch * 5};
+    }
+
+    map<string, double> readBaseline(const string& filename) {
+        map<string, double> baseline;
+        ifstream in(filename);
+        string line;
+        getline(in, line); // header
+        while (getline(in, line)) {
+            stringstream fields(line);
+            string name, ns;
+            if (getline(fields, name, ',') && getline(fields, ns, ',')) {
+                baseline[name] = stod(ns);
+            }
+        }
+        return baseline;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    string outFile = "bench.csv";
+    string baselineFile = "";
+    double tolerance = 10; // percent
+    string filter = "";
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-out" && i + 1 < argc) {
+            outFile = argv[++i];
+        } else if (arg == "-baseline" && i + 1 < argc) {
+            baselineFile = argv[++i];
+        } else if (arg == "-tolerance" && i + 1 < argc) {
+            tolerance = stod(argv[++i]);
+        } else if (arg == "-filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            cerr << "Usage: " << argv[0] << " [-out file] [-baseline file] [-tolerance percent] [-filter text]" << endl;
+            return 1;
+        }
+    }
+
+    // Everything the engine prints goes nowhere, so only the work itself is timed
+    NullSink quiet;
+    setOutputSink(&quiet);
+
+    Game game(false);
+    game.seed(1);
+    game.initialize({{"Owner", 'G'}, {"Visitor", 'B'}});
+    Player* owner = game.getPlayers()[0];
+    Player* visitor = game.getPlayers()[1];
+    Board& board = game.getBoard();
+    game.getDice().roll(game.getRng());
+
+    Property* academic = board.findProperty("ML");
+    Property* residence = board.findProperty("MKV");
+    Property* gym = board.findProperty("PAC");
+    owner->acquireProperty(board.findProperty("AL"));
+    owner->acquireProperty(academic);
+    owner->acquireProperty(residence);
+    owner->acquireProperty(board.findProperty("UWP"));
+    owner->acquireProperty(gym);
+    static_cast<AcademicBuilding*>(academic)->setImprovements(2);
+    AcademicBuilding* monopolyBuilding = static_cast<AcademicBuilding*>(academic);
+
+    // The visitor pays rent and gets it straight back, so balances never drift
+    auto landOn = [&](Property* property) {
+        return [&, property] {
+            int before = visitor->getMoney();
+            property->landedOn(game, visitor);
+            int rent = before - visitor->getMoney();
+            visitor->receiveMoney(rent);
+            owner->receiveMoney(-rent);
+            consumed = consumed + rent;
+        };
+    };
+
+    CommandInterpreter interpreter(&game, false);
+    const string saveFile = outFile + ".save"; // scratch file for the save and load benchmarks, removed at the end
+
+    vector<unique_ptr<DecisionProvider>> bots;
+    HeadlessEngine engine;
+    engine.seed(7);
+    for (const char* name : {"buy-everything", "monopoly", "hoarder", "default"}) {
+        bots.push_back(makeStrategy(name, engine.getGame()));
+    }
+    engine.setSeatDecisions({bots[0].get(), bots[1].get(), bots[2].get(), bots[3].get()});
+
+    vector<pair<string, function<void()>>> benchmarks = {
+        {"landedOn.academic", landOn(academic)},
+        {"landedOn.residence", landOn(residence)},
+        {"landedOn.gym", landOn(gym)},
+        {"ownsMonopoly", [&] { consumed = consumed + owner->ownsMonopoly(monopolyBuilding); }},
+        {"getNetWorth", [&] { consumed = consumed + owner->getNetWorth(); }},
+        {"getPropertyByName", [&] { consumed = consumed + (board.getPropertyByName("REV") != nullptr); }},
+        {"display", [&] { board.display(game.getPlayers()); }},
+        {"parseCommand.assets", [&] { interpreter.parseCommand("assets"); }},
+        {"parseCommand.invalid", [&] { interpreter.parseCommand("dance wildly"); }},
+        {"saveGame", [&] { game.saveGame(saveFile); }},
+        {"loadGame", [&] { game.loadGame(saveFile); }},
+        {"newGame.4players", [&] {
+            Game fresh(false);
+            fresh.initialize({{"A", 'G'}, {"B", 'B'}, {"C", 'D'}, {"D", 'P'}});
+            consumed = consumed + fresh.getSeatCount();
+        }},
+        {"botGame.4players", [&] { consumed = consumed + engine.play(4).turns; }},
+    };
+
+    // Loading replaces the players, so the file holds the same position every time
+    game.saveGame(saveFile);
+
+    vector<Result> results;
+    for (const auto& [name, op] : benchmarks) {
+        if (!filter.empty() && name.find(filter) == string::npos) continue;
+        results.push_back(measure(name, op));
+        // The load benchmark swaps the Player objects; pick the fresh ones up again
+        owner = game.getPlayers()[0];
+        visitor = game.getPlayers()[1];
+    }
+    setOutputSink(nullptr);
+    remove(saveFile.c_str());
+
+    ofstream csv(outFile);
+    if (!csv) {
+        cerr << "Cannot write " << outFile << endl;
+        return 1;
+    }
+    csv << "name,ns_per_op,ops_per_sec,iterations" << endl;
+    for (const Result& r : results) {
+        csv << r.name << ',' << r.nsPerOp << ',' << 1e9 / r.nsPerOp << ',' << r.iterations << endl;
+    }
+
+    map<string, double> baseline;
+    if (!baselineFile.empty()) {
+        baseline = readBaseline(baselineFile);
+    }
+    bool regressed = false;
+    printf("%-22s %14s %14s", "Benchmark", "ns/op", "ops/s");
+    printf(baseline.empty() ? "\n" : " %10s\n", "vs base");
+    for (const Result& r : results) {
+        printf("%-22s %14.1f %14.0f", r.name.c_str(), r.nsPerOp, 1e9 / r.nsPerOp);
+        auto it = baseline.find(r.name);
+        if (it != baseline.end()) {
+            double change = 100 * (r.nsPerOp - it->second) / it->second;
+            bool slower = change > tolerance;
+            regressed = regressed || slower;
+            printf(" %+9.1f%%%s", change, slower ? "  REGRESSION" : "");
+        }
+        printf("\n");
+    }
+    cout << "Results written to " << outFile << endl;
+    return regressed ? 1 : 0;
+}
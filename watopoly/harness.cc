@@ -2,6 +2,11 @@ import <iostream>;
 import <fstream>;
 import <sstream>;
 import <string>;
+import <chrono>;
+import <memory>;
+import <random>;
+import <cstdio>;
+import <vector>;
 import watopoly;
 
 using namespace std;
@@ -12,6 +17,18 @@ using namespace std;
 int main(int argc, char *argv[]) {
     bool testingMode = false;
     string loadFile = "";
+    int headlessGames = 0;
+    int headlessPlayers = 4;
+    bool seeded = false;
+    bool diffBoard = false;
+    string outputMode = "console";
+    string journalFile = "";
+    string recordFile = "";
+    string replayFile = "";
+    vector<string> botStrategies;
+    bool analyze = false;
+    bool roi = false;
+    unsigned long long seed = 0;
     
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -20,27 +37,212 @@ int main(int argc, char *argv[]) {
             testingMode = true;
         } else if (arg == "-load" && i + 1 < argc) {
             loadFile = argv[++i];
+        } else if (arg == "-headless" && i + 1 < argc) {
+            headlessGames = stoi(argv[++i]);
+        } else if (arg == "-players" && i + 1 < argc) {
+            headlessPlayers = stoi(argv[++i]);
+        } else if (arg == "-record" && i + 1 < argc) {
+            recordFile = argv[++i];
+        } else if (arg == "-replay" && i + 1 < argc) {
+            replayFile = argv[++i];
+        } else if (arg == "-bots" && i + 1 < argc) {
+            stringstream list(argv[++i]);
+            string name;
+            while (getline(list, name, ',')) {
+                botStrategies.push_back(name);
+            }
+        } else if (arg == "-roi") {
+            roi = true;
+        } else if (arg == "-analyze") {
+            analyze = true;
+        } else if (arg == "-journal" && i + 1 < argc) {
+            journalFile = argv[++i];
+        } else if (arg == "-quiet") {
+            outputMode = "quiet";
+        } else if (arg == "-buffered") {
+            outputMode = "buffered";
+        } else if (arg == "-ansi") {
+            diffBoard = true;
+        } else if (arg == "-seed" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+            seeded = true;
         }
     }
     
+    // Headless mode: play whole games with automatic answers and report throughput
+    // (one core, -seed 42: about 11k games/s with 4 players and 24k with 2; watopoly-sim spreads over cores)
+    if (headlessGames > 0) {
+        HeadlessEngine engine;
+        if (seeded) {
+            engine.seed(seed);
+        }
+        int finished = 0;
+        long long totalTurns = 0;
+        auto start = chrono::steady_clock::now();
+        for (int g = 0; g < headlessGames; ++g) {
+            GameResult result = engine.play(headlessPlayers);
+            finished += result.finished;
+            totalTurns += result.turns;
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << "Played " << headlessGames << " games (" << finished << " to bankruptcy), "
+             << totalTurns / headlessGames << " turns on average, in " << elapsed.count() << "s ("
+             << headlessGames / elapsed.count() << " games/s)" << endl;
+        return 0;
+    }
+    
+    // Analysis mode: long-run landing odds for every tile of the board files
+    if (analyze) {
+        Board board;
+        auto start = chrono::steady_clock::now();
+        LandingAnalysis analysis = analyzeLandings(board);
+        chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+        cout << "Pos  Tile            Landing/roll  Landing/turn" << endl;
+        for (int pos = 0; pos < board.getTileCount(); ++pos) {
+            printf("%3d  %-14s  %11.4f%%  %11.4f%%\n", pos, board.getTile(pos)->getName().c_str(),
+                   100 * analysis.landing[pos], 100 * analysis.landing[pos] * analysis.rollsPerTurn);
+        }
+        cout << "In Tims Line: " << 100 * (analysis.inTimsLine[0] + analysis.inTimsLine[1] + analysis.inTimsLine[2])
+             << "% of rolls, " << analysis.rollsPerTurn << " rolls per turn" << endl;
+        cout << "Solved in " << analysis.iterations << " iterations, " << elapsed.count() << " us" << endl;
+        return 0;
+    }
+    
+    // ROI mode: what each level of development earns back, block by block
+    if (roi) {
+        Board board;
+        LandingAnalysis analysis = analyzeLandings(board);
+        auto start = chrono::steady_clock::now();
+        vector<BlockReturn> returns = improvementReturns(board, analysis);
+        chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+        cout << "Block   Level   Cost  Rent/turn  Marginal  Payback(turns)  Return/$" << endl;
+        for (const BlockReturn& row : returns) {
+            printf("%-7s %5d  %5d  %9.2f  %8.2f  %14.1f  %8.5f\n", row.block.c_str(), row.level, row.cost,
+                   row.rentPerTurn, row.marginalRent, row.paybackTurns, row.returnPerDollar);
+        }
+        cout << "Computed in " << elapsed.count() << " us" << endl;
+        return 0;
+    }
+    
+    // Replay mode: rerun a recorded session with no rendering, check where it ends up and time it
+    if (!replayFile.empty()) {
+        try {
+            Game game(recordedInTestingMode(replayFile));
+            ReplayReport report = replaySession(replayFile, game);
+            cout << "Replayed " << report.commands << " commands in " << report.seconds << "s ("
+                 << report.commands / report.seconds << " commands/s)" << endl;
+            if (report.divergedAt) {
+                cout << "Command " << report.divergedAt << " replayed differently" << endl;
+            }
+            cout << "Final state " << hex << report.actualHash;
+            if (report.expectedHash == report.actualHash) {
+                cout << " matches the recording";
+            } else {
+                cout << " differs from the recorded " << report.expectedHash;
+            }
+            cout << dec << endl;
+            return report.matches() ? 0 : 2;
+        } catch (const exception& e) {
+            cerr << "Cannot replay " << replayFile << ": " << e.what() << endl;
+            return 1;
+        }
+    }
+    
+    // A recording always names its seed, so pick one if none was given
+    if (!recordFile.empty() && !seeded) {
+        seed = random_device{}();
+        seeded = true;
+    }
+    
+    // Engine messages: interactive console, one write per block, or nothing at all
+    NullSink quietSink;
+    BufferedSink bufferedSink;
+    if (outputMode == "quiet") {
+        setOutputSink(&quietSink);
+    } else if (outputMode == "buffered") {
+        setOutputSink(&bufferedSink);
+    }
+
     // Create the game
     Game game(testingMode);
+    if (seeded) {
+        game.seed(seed);
+    }
+    if (diffBoard) {
+        game.getBoard().setDiffRendering(true);
+    }
+    
+    // Bots fill the last seats, one per strategy listed; searching bots get every core
+    vector<unique_ptr<DecisionProvider>> bots;
+    for (const string& name : botStrategies) {
+        try {
+            bots.push_back(makeStrategy(name, game, 0));
+        } catch (const exception& e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
+    
+    // A journal from an earlier session takes precedence over -load and setup
+    Journal journal(journalFile);
+    bool recovered = false;
+    if (!journalFile.empty()) {
+        try {
+            recovered = journal.recover(game);
+        } catch (const exception& e) {
+            cerr << "Cannot recover from " << journalFile << ": " << e.what() << endl;
+            return 1;
+        }
+        if (recovered) {
+            output() << "Recovered game from " << journalFile << endl;
+        }
+    }
     
     // Load game if specified
-    if (!loadFile.empty()) {
+    if (recovered) {
+        // Players and board already restored
+    } else if (!loadFile.empty()) {
         game.loadGame(loadFile);
     } else {
         // Ask for the number of players
         int numPlayers;
-        cout << "Enter the number of players (2-6): ";
+        output() << "Enter the number of players (2-6): ";
         cin >> numPlayers;
         
         if (numPlayers < 2 || numPlayers > 6) {
-            cout << "Invalid number of players. Setting to 4." << endl;
+            output() << "Invalid number of players. Setting to 4." << endl;
             numPlayers = 4;
         }
         
-        game.initialize(numPlayers);
+        int botSeats = bots.size();
+        if (botSeats >= numPlayers) {
+            output() << "Bots fill empty seats, so one is kept for you." << endl;
+            botSeats = numPlayers - 1;
+        }
+        game.initialize(numPlayers, botSeats);
+    }
+    
+    // Everyone else answers at the console
+    ConsoleDecisions console;
+    SeatedDecisions seated{game};
+    if (!bots.empty()) {
+        int seatCount = game.getSeatCount();
+        int botSeats = min<int>(bots.size(), seatCount - 1);
+        vector<DecisionProvider*> bySeat(seatCount, &console);
+        for (int i = 0; i < botSeats; ++i) {
+            bySeat[seatCount - botSeats + i] = bots[i].get();
+        }
+        seated.assign(bySeat);
+        game.setDecisionProvider(&seated);
+    }
+    
+    if (!journalFile.empty()) {
+        journal.start(game);
+    }
+    unique_ptr<SessionRecorder> recorder;
+    if (!recordFile.empty()) {
+        recorder = make_unique<SessionRecorder>(recordFile);
+        recorder->start(game, seed);
     }
     
     // Main game loop
@@ -0,0 +1,138 @@
+import <iostream>;
+import <fstream>;
+import <sstream>;
+import <string>;
+import <vector>;
+import <chrono>;
+import <cstdio>;
+import watopoly;
+
+using namespace std;
+
+// Simulation farm driver.
+// Plays a batch of automatic games on every core and prints the merged results.
+// The job comes from a spec file of "key value" lines, from flags, or both:
+//   games 1000000
+//   players 4
+//   strategies default,frugal
+//   seeds 0-999999      (or "seed 0", the first of games consecutive seeds)
+//   threads 0           (0 uses every core)
+//   turns 1000
+//   grain 64
+
+namespace {
+    vector<string> splitList(const string& list) {
+        vector<string> names;
+        stringstream in(list);
+        string name;
+        while (getline(in, name, ',')) {
+            if (!name.empty()) names.push_back(name);
+        }
+        return names;
+    }
+
+    void printUsage(const char* program) {
+        cerr << "Usage: " << program << " [-spec file] [-games n] [-players n] [-strategies a,b]"
+             << " [-seed s | -seeds a-b] [-threads n] [-turns n] [-grain n]" << endl;
+    }
+
+    // Applies one spec setting; false if the key is unknown or the value is not a number
+    bool applySetting(SimJob& job, const string& key, const string& value) {
+        try {
+            if (key == "games") {
+                job.games = stoull(value);
+            } else if (key == "players") {
+                job.players = stoi(value);
+            } else if (key == "strategies") {
+                job.strategies = splitList(value);
+            } else if (key == "seed") {
+                job.firstSeed = stoull(value);
+            } else if (key == "seeds") {
+                size_t dash = value.find('-');
+                if (dash == string::npos) return false;
+                job.firstSeed = stoull(value.substr(0, dash));
+                unsigned long long last = stoull(value.substr(dash + 1));
+                if (last < job.firstSeed) return false;
+                job.games = last - job.firstSeed + 1;
+            } else if (key == "threads") {
+                job.threads = stoul(value);
+            } else if (key == "turns") {
+                job.maxTurns = stoi(value);
+            } else if (key == "grain") {
+                job.grain = stoull(value);
+            } else {
+                return false;
+            }
+        } catch (const exception&) {
+            return false;
+        }
+        return true;
+    }
+
+    bool readSpec(SimJob& job, const string& filename) {
+        ifstream in(filename);
+        if (!in) {
+            cerr << "Cannot open job spec " << filename << endl;
+            return false;
+        }
+        string line;
+        while (getline(in, line)) {
+            string key, value;
+            stringstream fields(line);
+            if (!(fields >> key) || key[0] == '#') continue;
+            fields >> value;
+            if (!applySetting(job, key, value)) {
+                cerr << "Bad setting in " << filename << ": " << line << endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    SimJob job;
+
+    // Flags are read in order, so they override a spec file given before them
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-spec" && i + 1 < argc) {
+            if (!readSpec(job, argv[++i])) return 1;
+        } else if (arg.size() > 1 && arg[0] == '-' && i + 1 < argc) {
+            if (!applySetting(job, arg.substr(1), argv[++i])) {
+                cerr << "Unknown or bad option " << arg << endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    SimTotals totals;
+    auto start = chrono::steady_clock::now();
+    try {
+        totals = runSimulation(job);
+    } catch (const exception& e) {
+        cerr << "Simulation failed: " << e.what() << endl;
+        return 1;
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    if (totals.games == 0) {
+        cout << "No games played" << endl;
+        return 0;
+    }
+    cout << "Played " << totals.games << " games (" << totals.finished << " to bankruptcy), "
+         << totals.turns / totals.games << " turns on average, in " << elapsed.count() << "s ("
+         << totals.games / elapsed.count() << " games/s)" << endl;
+    for (size_t seat = 0; seat < totals.seatWins.size(); ++seat) {
+        printf("Seat %-9zu wins %6.2f%%\n", seat + 1, 100.0 * totals.seatWins[seat] / totals.games);
+    }
+    for (const auto& [name, seats] : totals.strategyGames) {
+        printf("%-14s wins %6.2f%% of %llu seats\n", name.c_str(),
+               100.0 * totals.strategyWins[name] / seats, (unsigned long long)seats);
+    }
+    return 0;
+}
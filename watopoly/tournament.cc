@@ -0,0 +1,111 @@
+import <iostream>;
+import <fstream>;
+import <sstream>;
+import <string>;
+import <vector>;
+import <chrono>;
+import <cstdio>;
+import watopoly;
+
+using namespace std;
+
+// Strategy tournament driver.
+// Plays round-robin or Swiss tables of bot strategies on every core and
+// writes their ratings to a CSV file, best first.
+
+namespace {
+    vector<string> splitList(const string& list) {
+        vector<string> items;
+        stringstream in(list);
+        string item;
+        while (getline(in, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+
+    // "2-6" or "2,4,6"
+    vector<int> parseCounts(const string& text) {
+        vector<int> counts;
+        size_t dash = text.find('-');
+        if (dash != string::npos) {
+            int first = stoi(text.substr(0, dash));
+            int last = stoi(text.substr(dash + 1));
+            for (int n = first; n <= last; ++n) counts.push_back(n);
+        } else {
+            for (const string& item : splitList(text)) counts.push_back(stoi(item));
+        }
+        return counts;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    TournamentConfig config;
+    string csvFile = "ratings.csv";
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "-strategies" && i + 1 < argc) {
+                config.strategies = splitList(argv[++i]);
+            } else if (arg == "-format" && i + 1 < argc) {
+                string format = argv[++i];
+                if (format != "swiss" && format != "round-robin") {
+                    cerr << "Unknown format " << format << endl;
+                    return 1;
+                }
+                config.swiss = format == "swiss";
+            } else if (arg == "-players" && i + 1 < argc) {
+                config.playerCounts = parseCounts(argv[++i]);
+            } else if (arg == "-rounds" && i + 1 < argc) {
+                config.rounds = stoi(argv[++i]);
+            } else if (arg == "-repeats" && i + 1 < argc) {
+                config.repeats = stoi(argv[++i]);
+            } else if (arg == "-seed" && i + 1 < argc) {
+                config.seed = stoull(argv[++i]);
+            } else if (arg == "-turns" && i + 1 < argc) {
+                config.maxTurns = stoi(argv[++i]);
+            } else if (arg == "-threads" && i + 1 < argc) {
+                config.threads = stoul(argv[++i]);
+            } else if (arg == "-csv" && i + 1 < argc) {
+                csvFile = argv[++i];
+            } else {
+                cerr << "Usage: " << argv[0] << " -strategies a,b,... [-format round-robin|swiss] [-players 2-6]"
+                     << " [-rounds n] [-repeats n] [-seed s] [-turns n] [-threads n] [-csv file]" << endl;
+                return 1;
+            }
+        }
+    } catch (const exception&) {
+        cerr << "Bad number in the arguments" << endl;
+        return 1;
+    }
+
+    vector<Rating> ratings;
+    auto start = chrono::steady_clock::now();
+    try {
+        ratings = runTournament(config);
+    } catch (const exception& e) {
+        cerr << "Tournament failed: " << e.what() << endl;
+        return 1;
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    ofstream csv(csvFile);
+    if (!csv) {
+        cerr << "Cannot write " << csvFile << endl;
+        return 1;
+    }
+    csv << "rank,strategy,rating,ci_low,ci_high,games,wins,score" << endl;
+    unsigned long long games = 0;
+    printf("Rank  Strategy        Rating  95%% interval       Games   Wins  Score\n");
+    for (size_t i = 0; i < ratings.size(); ++i) {
+        const Rating& r = ratings[i];
+        csv << i + 1 << ',' << r.strategy << ',' << r.rating << ',' << r.low << ',' << r.high << ','
+            << r.games << ',' << r.wins << ',' << r.score << endl;
+        printf("%4zu  %-14s  %6.0f  [%6.0f, %6.0f]  %6llu %6llu  %5.3f\n", i + 1, r.strategy.c_str(), r.rating,
+               r.low, r.high, (unsigned long long)r.games, (unsigned long long)r.wins, r.score);
+        games += r.games;
+    }
+    cout << "Played " << games << " seats in " << elapsed.count() << "s, ratings written to " << csvFile << endl;
+    return 0;
+}